@@ -0,0 +1,94 @@
+#!/usr/bin/env python3
+# Report compile time and object size of a translation unit containing
+# a parser with a given number of options.
+#
+# Usage: instantiation.py <include dir> <compiler> [compiler args...]
+
+import os
+import subprocess
+import sys
+import tempfile
+import time
+
+SIZES = [10, 100, 500]
+
+
+def generate(n):
+	lines = [
+		'#include <conflict/conflict.hpp>',
+		'',
+		f'uint64_t flags[{n // 64 + 1}];',
+		f'uint64_t counters[{n}];',
+		f'uint64_t choices[{n}];',
+		f'std::string_view strings[{n}];',
+		f'int values[{n}];',
+		'',
+		'constexpr auto parser = conflict::parser{',
+	]
+
+	for i in range(n):
+		info = f'{{"opt{i}", "Option {i}"}}'
+
+		kind = i % 5
+
+		if kind == 0:
+			lines.append(f'\tconflict::option{{{info}, flags[{i // 64}], uint64_t{{1}} << {i % 64}}},')
+		elif kind == 1:
+			lines.append(f'\tconflict::counter_option{{{info}, counters[{i}]}},')
+		elif kind == 2:
+			lines.append(f'\tconflict::string_option{{{info}, "str", strings[{i}]}},')
+		elif kind == 3:
+			lines.append(f'\tconflict::value_option{{{info}, "n", values[{i}]}},')
+		else:
+			lines.append(f'\tconflict::choice{{{info}, conflict::choice_mode::combine, choices[{i}],')
+			lines.append('\t\tconflict::flag{{"a"}, 1}, conflict::flag{{"b"}, 2}},')
+
+	lines[-1] = lines[-1].rstrip(',')
+	lines += [
+		'};',
+		'',
+		'int main(int argc, char **argv) {',
+		'\tif (conflict::complete(parser, argc - 1, argv + 1))',
+		'\t\treturn 0;',
+		'',
+		'\tparser.apply_defaults();',
+		'\tconflict::default_report(parser.parse(argc - 1, argv + 1));',
+		'\tparser.print_help();',
+		'\tconflict::print_completion(parser, conflict::shell::bash, "prog");',
+		'}',
+	]
+
+	return '\n'.join(lines) + '\n'
+
+
+def text_size(obj):
+	try:
+		out = subprocess.run(['size', obj], capture_output=True, text=True, check=True).stdout
+		return int(out.splitlines()[1].split()[0])
+	except (OSError, subprocess.CalledProcessError, IndexError, ValueError):
+		return os.path.getsize(obj)
+
+
+def main():
+	include_dir = sys.argv[1]
+	compiler = sys.argv[2:]
+
+	print(f'{"options":>8} {"compile (s)":>12} {"text (bytes)":>13}')
+
+	with tempfile.TemporaryDirectory() as tmp:
+		for n in SIZES:
+			src = os.path.join(tmp, f'parser{n}.cpp')
+			obj = os.path.join(tmp, f'parser{n}.o')
+
+			with open(src, 'w') as f:
+				f.write(generate(n))
+
+			start = time.monotonic()
+			subprocess.run(compiler + ['-std=c++17', '-O2', '-I', include_dir, '-c', src, '-o', obj], check=True)
+			elapsed = time.monotonic() - start
+
+			print(f'{n:>8} {elapsed:>12.2f} {text_size(obj):>13}')
+
+
+if __name__ == '__main__':
+	main()
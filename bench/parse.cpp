@@ -0,0 +1,103 @@
+#include <conflict/conflict.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <utility>
+
+namespace {
+
+template <size_t N>
+struct name_table {
+	constexpr name_table()
+	: data{} {
+		for (size_t i = 0; i < N; i++) {
+			data[i][0] = 'o';
+			data[i][1] = '0' + i / 100 % 10;
+			data[i][2] = '0' + i / 10 % 10;
+			data[i][3] = '0' + i % 10;
+		}
+	}
+
+	std::string_view operator[](size_t i) const {
+		return {data[i], 4};
+	}
+
+	char data[N][4];
+};
+
+constexpr name_table<500> names{};
+
+uint64_t flags[500 / 64 + 1];
+
+template <size_t ...Is>
+constexpr auto make_parser(std::index_sequence<Is...>) {
+	return conflict::parser{
+		conflict::option{{std::string_view{names.data[Is], 4}}, flags[Is / 64], uint64_t{1} << (Is % 64)}...
+	};
+}
+
+constexpr auto parser10 = make_parser(std::make_index_sequence<10>{});
+constexpr auto parser100 = make_parser(std::make_index_sequence<100>{});
+constexpr auto parser500 = make_parser(std::make_index_sequence<500>{});
+
+constexpr size_t n_args = 1000;
+
+// Returns the average time spent per argument, in nanoseconds.
+template <typename P>
+double measure(const P &parser, std::string_view arg) {
+	std::vector<std::string_view> args(n_args, arg);
+
+	size_t rounds = 0;
+	std::chrono::steady_clock::duration total{};
+
+	while (total < std::chrono::milliseconds{100}) {
+		auto start = std::chrono::steady_clock::now();
+		auto st = parser.parse(args);
+		total += std::chrono::steady_clock::now() - start;
+
+		if (!st) {
+			conflict::default_report(st);
+		}
+
+		rounds++;
+	}
+
+	return std::chrono::duration<double, std::nano>{total}.count() / (rounds * n_args);
+}
+
+template <typename P>
+void report(const P &parser, size_t n) {
+	std::string first = "--" + std::string{names[0]};
+	std::string last = "--" + std::string{names[n - 1]};
+
+	std::printf("%8zu %14.1f %14.1f\n", n, measure(parser, first), measure(parser, last));
+}
+
+// The same options, registered at run time and reached through a fallback.
+void report_dynamic(size_t n) {
+	conflict::dynamic_parser plugins;
+
+	for (size_t i = 0; i < n; i++)
+		plugins.add(conflict::option{{names[i]}, flags[i / 64], uint64_t{1} << (i % 64)});
+
+	auto parser = conflict::parser{};
+	parser.attach(plugins);
+
+	report(parser, n);
+}
+
+} // namespace anonymous
+
+int main() {
+	std::printf("%8s %14s %14s\n", "options", "first (ns/arg)", "last (ns/arg)");
+
+	report(parser10, 10);
+	report(parser100, 100);
+	report(parser500, 500);
+
+	std::printf("\n%8s %14s %14s\n", "dynamic", "first (ns/arg)", "last (ns/arg)");
+
+	report_dynamic(10);
+	report_dynamic(100);
+	report_dynamic(500);
+}
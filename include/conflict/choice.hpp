@@ -3,11 +3,11 @@
 #include <string_view>
 #include <cstdint>
 #include <array>
-#include <cassert>
 
 #include <conflict/info.hpp>
 #include <conflict/error.hpp>
 #include <conflict/detail.hpp>
+#include <conflict/provenance.hpp>
 
 namespace conflict {
 
@@ -30,8 +30,28 @@ struct choice {
 	static constexpr bool needs_arg = true;
 
 	template <typename ...Ts>
-	choice(option_info info, choice_mode mode, uint64_t &target, Ts ...ts)
-	: info{info}, mode{mode}, target{target}, flags{ts...} { }
+	constexpr choice(option_info info, choice_mode mode, uint64_t &target, Ts ...ts)
+	: info{info}, mode{mode}, target{target}, flags{ts...} {
+		size_t n_defaults = 0;
+
+		for (size_t i = 0; i < N; i++) {
+			for (size_t j = 0; j < i; j++) {
+				if (flags[i].info.long_opt == flags[j].info.long_opt)
+					detail::invalid_configuration("duplicate choice flag name");
+			}
+
+			n_defaults += flags[i].set_by_default;
+		}
+
+		if (mode == choice_mode::replace && n_defaults > 1)
+			detail::invalid_configuration("multiple defaults for a replace mode choice");
+	}
+
+	template <typename ...Ts>
+	constexpr choice(option_info info, choice_mode mode, uint64_t &target, provenance &origin, Ts ...ts)
+	: choice{info, mode, target, ts...} {
+		this->origin = &origin;
+	}
 
 	option_info info;
 
@@ -40,6 +60,9 @@ struct choice {
 	uint64_t &target;
 	std::array<flag, N> flags;
 
+	// Optionally records where each bit of the target was set from.
+	provenance *origin = nullptr;
+
 	void print_argument_placeholder(detail::line_printer &pr) const {
 		if (mode == choice_mode::combine) {
 			pr.print(" a,-c,...");
@@ -70,15 +93,83 @@ struct choice {
 		}
 	}
 
+	template <typename H>
+	void hash_help(H &h) const {
+		h.add(static_cast<uint64_t>(mode));
+
+		for (auto &flg : flags) {
+			h.add(flg.info.long_opt);
+			h.add(flg.info.desc);
+		}
+	}
+
+	template <typename F>
+	void complete_arg(std::string_view word, F &&fn) const {
+		std::string_view head{};
+
+		if (mode == choice_mode::combine) {
+			auto comma = word.rfind(',');
+			size_t start = comma == std::string_view::npos ? 0 : comma + 1;
+
+			if (start < word.size() && word[start] == '-')
+				start++;
+
+			head = word.substr(0, start);
+			word = word.substr(start);
+		}
+
+		for (auto &flg : flags) {
+			if (flg.info.long_opt.substr(0, word.size()) == word)
+				fn(head, flg.info.long_opt);
+		}
+	}
+
+	template <typename W>
+	void dump_value(W &w) const {
+		if (mode == choice_mode::replace) {
+			for (auto &flg : flags) {
+				if (target == flg.flag_bit) {
+					w.string(flg.info.long_opt);
+					return;
+				}
+			}
+
+			w.null();
+			return;
+		}
+
+		w.begin_list();
+
+		for (auto &flg : flags) {
+			if (flg.flag_bit && (target & flg.flag_bit) == flg.flag_bit)
+				w.string(flg.info.long_opt);
+		}
+
+		w.end_list();
+	}
+
 	void apply_default() const {
+		if (origin)
+			origin->record(mode == choice_mode::replace ? ~uint64_t{0} : all_bits(), source::none);
+
 		for (auto &flg : flags) {
-			assert(!(flg.set_by_default && target
-					&& mode == choice_mode::replace));
 			target |= flg.set_by_default ? flg.flag_bit : 0;
+
+			if (origin && flg.set_by_default)
+				origin->record(mode == choice_mode::replace ? ~uint64_t{0} : flg.flag_bit, source::defaults);
 		}
 	}
 
-	status process_arg(std::string_view arg) const {
+	constexpr uint64_t all_bits() const {
+		uint64_t bits = 0;
+
+		for (auto &flg : flags)
+			bits |= flg.flag_bit;
+
+		return bits;
+	}
+
+	status process_arg(std::string_view arg, source src = source::argv) const {
 		size_t j = 0;
 
 		bool updated = false;
@@ -106,13 +197,17 @@ struct choice {
 						}
 
 						target = flag.flag_bit;
-					} else {
-						assert(mode == choice_mode::combine);
 
+						if (origin)
+							origin->record(~uint64_t{0}, src);
+					} else {
 						if (unset)
 							target &= ~flag.flag_bit;
 						else
 							target |= flag.flag_bit;
+
+						if (origin)
+							origin->record(flag.flag_bit, src);
 					}
 
 					found = true;
@@ -136,4 +231,7 @@ struct choice {
 template <typename ...Ts>
 choice(option_info, choice_mode, uint64_t &, Ts ...) -> choice<sizeof...(Ts)>;
 
+template <typename ...Ts>
+choice(option_info, choice_mode, uint64_t &, provenance &, Ts ...) -> choice<sizeof...(Ts)>;
+
 } // namespace conflict
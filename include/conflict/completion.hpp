@@ -0,0 +1,345 @@
+#pragma once
+
+#include <string_view>
+#include <iostream>
+#include <vector>
+
+#include <conflict/parser.hpp>
+
+namespace conflict {
+
+enum class shell {
+	bash,
+	zsh,
+	fish
+};
+
+namespace detail {
+	// Print a string inside of single quotes, escaping as needed.
+	// `special` characters are additionally escaped with a backslash.
+	inline void print_quoted(std::string_view str, std::string_view special = {}) {
+		for (auto c : str) {
+			if (c == '\'')
+				std::cout << "'\\''";
+			else if (special.find(c) != std::string_view::npos)
+				std::cout << '\\' << c;
+			else
+				std::cout << c;
+		}
+	}
+
+	inline void print_values(const option_ref &opt, char sep) {
+		bool first = true;
+
+		complete_arg(opt, {}, [&] (std::string_view, std::string_view value) {
+			if (!first)
+				std::cout << sep;
+			print_quoted(value);
+			first = false;
+		});
+	}
+
+	inline bool has_values(const option_ref &opt) {
+		bool any = false;
+
+		complete_arg(opt, {}, [&] (std::string_view, std::string_view) {
+			any = true;
+		});
+
+		return any;
+	}
+
+	inline void print_function_name(std::string_view program) {
+		std::cout << "_";
+
+		for (auto c : program) {
+			bool alnum = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')
+				|| (c >= '0' && c <= '9');
+			std::cout << (alnum ? c : '_');
+		}
+	}
+
+	inline void print_bash_completion(const option_ref *opts, size_t n, std::string_view program) {
+		auto print_names = [] (const option_info &info, char sep) {
+			if (info.short_opt)
+				std::cout << '-' << info.short_opt;
+
+			if (info.short_opt && info.long_opt.size())
+				std::cout << sep;
+
+			if (info.long_opt.size())
+				std::cout << "--" << info.long_opt;
+		};
+
+		print_function_name(program);
+		std::cout << "() {\n";
+		std::cout << "\tlocal cur=\"${COMP_WORDS[COMP_CWORD]}\" prev=\"${COMP_WORDS[COMP_CWORD-1]}\"\n\n";
+		std::cout << "\tcase \"$prev\" in\n";
+
+		for (size_t i = 0; i < n; i++) {
+			if (!opts[i].needs_arg || opts[i].info->hidden)
+				continue;
+
+			std::cout << "\t\t";
+			print_names(*opts[i].info, '|');
+			std::cout << ")\n";
+
+			if (has_values(opts[i])) {
+				std::cout << "\t\t\tCOMPREPLY=($(compgen -W '";
+				print_values(opts[i], ' ');
+				std::cout << "' -- \"$cur\"))\n";
+			} else {
+				std::cout << "\t\t\tCOMPREPLY=($(compgen -f -- \"$cur\"))\n";
+			}
+
+			std::cout << "\t\t\treturn;;\n";
+		}
+
+		std::cout << "\tesac\n\n";
+		std::cout << "\tif [[ \"$cur\" == -* ]]; then\n";
+		std::cout << "\t\tCOMPREPLY=($(compgen -W '";
+
+		bool first = true;
+
+		for (size_t i = 0; i < n; i++) {
+			if (opts[i].info->hidden)
+				continue;
+
+			if (!first)
+				std::cout << ' ';
+			print_names(*opts[i].info, ' ');
+			first = false;
+		}
+
+		std::cout << "' -- \"$cur\"))\n";
+		std::cout << "\t\treturn\n";
+		std::cout << "\tfi\n\n";
+		std::cout << "\tCOMPREPLY=($(compgen -f -- \"$cur\"))\n";
+		std::cout << "}\n\n";
+		std::cout << "complete -F ";
+		print_function_name(program);
+		std::cout << " " << program << "\n";
+	}
+
+	inline void print_zsh_completion(const option_ref *opts, size_t n, std::string_view program) {
+		std::cout << "#compdef " << program << "\n\n";
+		std::cout << "_arguments -s \\\n";
+
+		for (size_t i = 0; i < n; i++) {
+			auto &opt = opts[i];
+			auto &info = *opt.info;
+
+			if (info.hidden)
+				continue;
+
+			// Every option is marked as repeatable, since the parser
+			// accepts any option multiple times.
+			std::cout << "\t'*'";
+
+			if (info.short_opt && info.long_opt.size())
+				std::cout << '{';
+
+			if (info.short_opt)
+				std::cout << '-' << info.short_opt << (opt.needs_arg ? "+" : "");
+
+			if (info.short_opt && info.long_opt.size())
+				std::cout << ',';
+
+			if (info.long_opt.size())
+				std::cout << "--" << info.long_opt << (opt.needs_arg ? "=" : "");
+
+			if (info.short_opt && info.long_opt.size())
+				std::cout << '}';
+
+			std::cout << "'[";
+			print_quoted(info.desc, "[]");
+			std::cout << "]";
+
+			if (opt.needs_arg) {
+				std::cout << ':';
+				print_quoted(opt.argument_name, ":");
+
+				if (has_values(opt)) {
+					std::cout << ":(";
+					print_values(opt, ' ');
+					std::cout << ")";
+				} else {
+					std::cout << ":_files";
+				}
+			}
+
+			std::cout << "' \\\n";
+		}
+
+		std::cout << "\t'*:file:_files'\n";
+	}
+
+	inline void print_fish_completion(const option_ref *opts, size_t n, std::string_view program) {
+		for (size_t i = 0; i < n; i++) {
+			auto &opt = opts[i];
+			auto &info = *opt.info;
+
+			if (info.hidden)
+				continue;
+
+			std::cout << "complete -c " << program;
+
+			if (info.short_opt)
+				std::cout << " -s " << info.short_opt;
+
+			if (info.long_opt.size())
+				std::cout << " -l " << info.long_opt;
+
+			if (opt.needs_arg) {
+				if (has_values(opt)) {
+					std::cout << " -x -a '";
+					print_values(opt, ' ');
+					std::cout << "'";
+				} else {
+					std::cout << " -r -F";
+				}
+			}
+
+			if (info.desc.size()) {
+				std::cout << " -d '";
+				print_quoted(info.desc);
+				std::cout << "'";
+			}
+
+			std::cout << "\n";
+		}
+	}
+
+	inline void print_completion(const option_ref *opts, size_t n, shell sh, std::string_view program) {
+		switch (sh) {
+			case shell::bash:
+				print_bash_completion(opts, n, program);
+				break;
+			case shell::zsh:
+				print_zsh_completion(opts, n, program);
+				break;
+			case shell::fish:
+				print_fish_completion(opts, n, program);
+				break;
+		}
+	}
+
+	// `names` are the sorted long option names, with the first `first` being
+	// empty, and `indices` the options they belong to. Hidden options are not
+	// offered, but their arguments are still completed.
+	inline void complete(const option_ref *opts, size_t n, const std::string_view *names,
+			const size_t *indices, size_t first, const std::vector<std::string_view> &args) {
+		auto cur = args.size() > 1 ? args.back() : std::string_view{};
+		auto prev = args.size() > 2 ? args[args.size() - 2] : std::string_view{};
+
+		// Complete the argument of the option named by `name`, if it takes one.
+		auto complete_value = [&] (std::string_view name, std::string_view head, std::string_view word) {
+			for (size_t i = 0; i < n; i++) {
+				auto &info = *opts[i].info;
+
+				if (!opts[i].needs_arg)
+					continue;
+
+				bool match = name.size() == 2 && name[0] == '-'
+					? info.short_opt && name[1] == info.short_opt
+					: name.size() > 2 && name.substr(2) == info.long_opt;
+
+				if (!match)
+					continue;
+
+				complete_arg(opts[i], word, [&] (std::string_view value_head, std::string_view value) {
+					std::cout << head << value_head << value << '\n';
+				});
+
+				return true;
+			}
+
+			return false;
+		};
+
+		if (cur.substr(0, 2) == "--") {
+			if (auto eq = cur.find('='); eq != std::string_view::npos) {
+				complete_value(cur.substr(0, eq), cur.substr(0, eq + 1), cur.substr(eq + 1));
+				return;
+			}
+		}
+
+		if (prev.size() > 1 && prev[0] == '-' && prev.find('=') == std::string_view::npos
+				&& complete_value(prev, {}, cur))
+			return;
+
+		if (cur.substr(0, 2) == "--") {
+			auto [lo, hi] = prefix_range(names, first, n, cur.substr(2));
+
+			for (size_t i = lo; i < hi; i++) {
+				if (!opts[indices[i]].info->hidden)
+					std::cout << "--" << names[i] << '\n';
+			}
+		} else if (cur == "-") {
+			for (size_t i = 0; i < n; i++) {
+				if (opts[i].info->short_opt && !opts[i].info->hidden)
+					std::cout << '-' << opts[i].info->short_opt << '\n';
+			}
+
+			for (size_t i = first; i < n; i++) {
+				if (!opts[indices[i]].info->hidden)
+					std::cout << "--" << names[i] << '\n';
+			}
+		}
+	}
+} // namespace detail
+
+template <typename ...Ts>
+void print_completion(const parser<Ts...> &p, shell sh, std::string_view program) {
+	auto refs = p.option_refs();
+
+	if (p.fallback) {
+		std::vector<detail::option_ref> all{refs.begin(), refs.end()};
+		p.fallback->append_option_refs(all);
+
+		detail::print_completion(all.data(), all.size(), sh, program);
+		return;
+	}
+
+	detail::print_completion(refs.data(), refs.size(), sh, program);
+}
+
+// Answer a completion query of the form `__complete <words...>`, where the
+// last word is the one being completed. Prints one candidate per line, and
+// returns whether the arguments were a completion query at all.
+template <typename ...Ts>
+bool complete(const parser<Ts...> &p, const std::vector<std::string_view> &args) {
+	if (!args.size() || args[0] != "__complete")
+		return false;
+
+	auto refs = p.option_refs();
+
+	if (p.fallback) {
+		std::vector<detail::option_ref> all{refs.begin(), refs.end()};
+		p.fallback->append_option_refs(all);
+
+		detail::ref_index longs{all, &option_info::long_opt};
+		detail::complete(all.data(), all.size(), longs.names.data(), longs.indices.data(),
+			longs.first, args);
+		return true;
+	}
+
+	detail::complete(refs.data(), refs.size(), p.long_index.names.data(), p.long_index.indices.data(),
+		p.long_index.first, args);
+
+	return true;
+}
+
+template <typename ...Ts>
+bool complete(const parser<Ts...> &p, int argc, char **argv) {
+	std::vector<std::string_view> args{argv, argv + argc};
+	return complete(p, args);
+}
+
+template <typename ...Ts>
+bool complete(const parser<Ts...> &p, int argc, const char **argv) {
+	std::vector<std::string_view> args{argv, argv + argc};
+	return complete(p, args);
+}
+
+} // namespace conflict
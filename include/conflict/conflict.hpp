@@ -1,8 +1,19 @@
 #pragma once
 
 #include <conflict/info.hpp>
+#include <conflict/constraint.hpp>
 #include <conflict/error.hpp>
+#include <conflict/provenance.hpp>
+#include <conflict/traits.hpp>
 #include <conflict/choice.hpp>
 #include <conflict/option.hpp>
+#include <conflict/fixed_vector.hpp>
 #include <conflict/string.hpp>
+#include <conflict/value.hpp>
+#include <conflict/list.hpp>
+#include <conflict/dynamic.hpp>
 #include <conflict/parser.hpp>
+#include <conflict/help_cache.hpp>
+#include <conflict/completion.hpp>
+#include <conflict/dump_writer.hpp>
+#include <conflict/dump.hpp>
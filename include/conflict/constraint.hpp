@@ -0,0 +1,38 @@
+#pragma once
+
+#include <string_view>
+
+namespace conflict {
+
+// A relation between two options, referred to by their long name. Given to
+// parser::constrain, which resolves it into option masks, so that the names
+// are not kept around in the options themselves.
+struct constraint {
+	enum class kind {
+		required,
+		conflicts,
+		depends
+	};
+
+	kind type;
+	std::string_view option;
+	// For required, the option whose presence lifts the requirement, if any.
+	std::string_view other;
+};
+
+// `option` must be given, unless `unless` is.
+constexpr constraint required(std::string_view option, std::string_view unless = {}) {
+	return constraint{constraint::kind::required, option, unless};
+}
+
+// `option` may not be given together with `other`.
+constexpr constraint conflicts(std::string_view option, std::string_view other) {
+	return constraint{constraint::kind::conflicts, option, other};
+}
+
+// `option` may only be given together with `other`.
+constexpr constraint depends(std::string_view option, std::string_view other) {
+	return constraint{constraint::kind::depends, option, other};
+}
+
+} // namespace conflict
@@ -2,16 +2,43 @@
 
 #include <iostream>
 #include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <type_traits>
+#include <array>
+#include <utility>
+#include <algorithm>
+#include <string_view>
 
 namespace conflict::detail {
+	// Reached when an invalid parser configuration is detected. This is
+	// deliberately not constexpr, so that constructing an invalid parser
+	// in a constant expression fails to compile.
+	[[noreturn]] inline void invalid_configuration(const char *what) {
+		std::cerr << "conflict: invalid configuration: " << what << '\n';
+		std::abort();
+	}
+
+	template <typename T, typename = void>
+	struct has_flag_bit : std::false_type { };
+
+	template <typename T>
+	struct has_flag_bit<T, std::void_t<decltype(T::flag_bit)>> : std::true_type { };
+
+	template <typename T, typename = void>
+	struct has_all_bits : std::false_type { };
+
+	template <typename T>
+	struct has_all_bits<T, std::void_t<decltype(std::declval<const T &>().all_bits())>> : std::true_type { };
+
 	struct line_printer {
 		void print_item(std::string_view str) {
-			std::cout << str;
+			out << str;
 			n_printed += str.size();
 		}
 
 		void print_item(char c) {
-			std::cout << c;
+			out << c;
 			n_printed++;
 		}
 
@@ -22,22 +49,236 @@ namespace conflict::detail {
 
 		void start_extra_line() {
 			n_printed = 0;
-			std::cout << "    ";
+			out << "    ";
 		}
 
 		void pad() {
 			size_t n = width_until_break;
 
 			if ((n_printed + 1) > width_until_break)
-				std::cout << '\n';
+				out << '\n';
 			else
 				n = width_until_break - n_printed;
 
 			for (size_t i = 0; i < n; i++)
-				std::cout << ' ';
+				out << ' ';
 		}
 
+		std::ostream &out;
 		size_t width_until_break = 32;
 		size_t n_printed = 0;
 	};
+
+	// One bit per option of a parser.
+	template <size_t N>
+	struct option_mask {
+		constexpr void set(size_t i) {
+			words[i / 64] |= uint64_t{1} << (i % 64);
+		}
+
+		constexpr bool test(size_t i) const {
+			return words[i / 64] & (uint64_t{1} << (i % 64));
+		}
+
+		constexpr option_mask operator&(const option_mask &other) const {
+			option_mask mask{};
+
+			for (size_t i = 0; i < words.size(); i++)
+				mask.words[i] = words[i] & other.words[i];
+
+			return mask;
+		}
+
+		constexpr option_mask operator~() const {
+			option_mask mask{};
+
+			for (size_t i = 0; i < words.size(); i++)
+				mask.words[i] = ~words[i];
+
+			return mask;
+		}
+
+		// Call `fn` with the index of every option in this mask.
+		template <typename F>
+		void for_each(F &&fn) const {
+			for (size_t i = 0; i < words.size(); i++) {
+				auto w = words[i];
+
+				for (size_t bit = 0; w; bit++, w >>= 1) {
+					if (w & 1)
+						fn(i * 64 + bit);
+				}
+			}
+		}
+
+		std::array<uint64_t, (N + 63) / 64> words{};
+	};
+
+	template <size_t I, typename T>
+	struct option_leaf {
+		static constexpr size_t index = I;
+
+		T value;
+	};
+
+	template <typename Is, typename ...Ts>
+	struct option_list_impl;
+
+	template <size_t ...Is, typename ...Ts>
+	struct option_list_impl<std::index_sequence<Is...>, Ts...> : option_leaf<Is, Ts>... {
+		constexpr option_list_impl(Ts ...ts)
+		: option_leaf<Is, Ts>{ts}... { }
+
+		template <typename F>
+		constexpr decltype(auto) apply(F &&fn) const {
+			return fn(static_cast<const option_leaf<Is, Ts> &>(*this).value...);
+		}
+
+		// Like apply, but passes the leaves, which also carry the index of each option.
+		template <typename F>
+		constexpr decltype(auto) apply_leaves(F &&fn) const {
+			return fn(static_cast<const option_leaf<Is, Ts> &>(*this)...);
+		}
+	};
+
+	// Flat storage for the options of a parser. Unlike std::tuple, this
+	// does not recurse over the elements, which keeps parsers with many
+	// options cheap to instantiate.
+	template <typename ...Ts>
+	using option_list = option_list_impl<std::index_sequence_for<Ts...>, Ts...>;
+
+	struct fnv1a {
+		void add_byte(unsigned char c) {
+			hash ^= c;
+			hash *= 0x100000001b3;
+		}
+
+		void add(uint64_t value) {
+			for (size_t i = 0; i < 8; i++)
+				add_byte(value >> (i * 8));
+		}
+
+		// Strings are length-prefixed, so that adjacent ones can't alias.
+		void add(std::string_view str) {
+			add(str.size());
+
+			for (auto c : str)
+				add_byte(c);
+		}
+
+		uint64_t hash = 0xcbf29ce484222325;
+	};
+
+	// Find the range of names in the sorted array `names` that are equal to `name`.
+	inline std::pair<size_t, size_t> equal_range(const std::string_view *names,
+			size_t n, std::string_view name) {
+		auto [lo, hi] = std::equal_range(names, names + n, name);
+		return {lo - names, hi - names};
+	}
+
+	// Find the range of names in the sorted array `names` that start with `prefix`.
+	inline std::pair<size_t, size_t> prefix_range(const std::string_view *names,
+			size_t first, size_t n, std::string_view prefix) {
+		auto lo = std::lower_bound(names + first, names + n, prefix);
+		auto hi = std::find_if(lo, names + n, [&] (std::string_view name) {
+			return name.substr(0, prefix.size()) != prefix;
+		});
+
+		return {lo - names, hi - names};
+	}
+
+	// Option names sorted lexicographically, so that all names sharing
+	// a prefix form one contiguous range. Options without a name sort
+	// to the front, before `first`.
+	template <size_t N>
+	struct name_index {
+		constexpr name_index(std::array<std::string_view, N> unsorted)
+		: names{unsorted}, indices{}, first{0} {
+			for (size_t i = 0; i < N; i++) {
+				indices[i] = i;
+
+				if (!names[i].size())
+					first++;
+			}
+
+			// Already sorted, which is the common case for group names.
+			if (first == N)
+				return;
+
+			// Heap sort, since this runs in constant expressions where
+			// quadratic sorts quickly exhaust the evaluation limits.
+			for (size_t i = N / 2; i-- > 0;)
+				sift_down(i, N);
+
+			for (size_t end = N; end-- > 1;) {
+				swap(0, end);
+				sift_down(0, end);
+			}
+		}
+
+		constexpr void swap(size_t a, size_t b) {
+			auto name = names[a];
+			names[a] = names[b];
+			names[b] = name;
+
+			auto index = indices[a];
+			indices[a] = indices[b];
+			indices[b] = index;
+		}
+
+		constexpr void sift_down(size_t root, size_t end) {
+			while (2 * root + 1 < end) {
+				size_t child = 2 * root + 1;
+
+				if (child + 1 < end && less(child, child + 1))
+					child++;
+
+				if (!less(root, child))
+					return;
+
+				swap(root, child);
+				root = child;
+			}
+		}
+
+		// Equal names are ordered by index, so that options sharing a name
+		// (e.g. a group) stay in declaration order.
+		constexpr bool less(size_t a, size_t b) const {
+			return names[a] < names[b] || (names[a] == names[b] && indices[a] < indices[b]);
+		}
+
+		constexpr size_t lower_bound(std::string_view name, size_t lo) const {
+			size_t hi = N;
+
+			while (lo < hi) {
+				size_t mid = lo + (hi - lo) / 2;
+
+				if (names[mid] < name)
+					lo = mid + 1;
+				else
+					hi = mid;
+			}
+
+			return lo;
+		}
+
+		// Index of the option called `name`, or N if there is none.
+		constexpr size_t find(std::string_view name) const {
+			size_t lo = lower_bound(name, first);
+			return lo < N && names[lo] == name ? indices[lo] : N;
+		}
+
+		// Positions of all the entries called `name`.
+		std::pair<size_t, size_t> equal_range(std::string_view name) const {
+			return detail::equal_range(names.data(), N, name);
+		}
+
+		std::pair<size_t, size_t> prefix_range(std::string_view prefix) const {
+			return detail::prefix_range(names.data(), first, N, prefix);
+		}
+
+		std::array<std::string_view, N> names;
+		std::array<size_t, N> indices;
+		size_t first;
+	};
 } // namespace conflict::detail
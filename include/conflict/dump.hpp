@@ -0,0 +1,59 @@
+#pragma once
+
+#include <string_view>
+#include <type_traits>
+#include <cstddef>
+#include <vector>
+
+#include <conflict/dump_writer.hpp>
+#include <conflict/parser.hpp>
+
+namespace conflict {
+
+// Write the values of all options, including those of the fallback, (and the
+// positional arguments, if given) into `buf`, without allocating. Options are
+// keyed by their long name, or their short name if they have no long one. Returns the length of the whole
+// dump, which is larger than `size` if it was truncated. The output is not
+// NUL-terminated.
+template <typename ...Ts>
+size_t dump(const parser<Ts...> &p, char *buf, size_t size, dump_format format,
+		const std::vector<std::string_view> *positional = nullptr) {
+	detail::dump_writer w{buf, size, format};
+
+	p.options.apply([&] (const auto &...ts) {
+		([&] (const auto &opt) {
+			if constexpr (detail::has_dump_value<std::decay_t<decltype(opt)>>::value) {
+				w.key(opt.info.long_opt.size() ? opt.info.long_opt
+						: std::string_view{&opt.info.short_opt, 1});
+				opt.dump_value(w);
+				w.end_entry();
+			}
+		}(ts), ...);
+	});
+
+	if (p.fallback)
+		p.fallback->dump_values(w);
+
+	if (positional) {
+		w.key("positional");
+		w.begin_list();
+
+		for (auto arg : *positional)
+			w.string(arg);
+
+		w.end_list();
+		w.end_entry();
+	}
+
+	w.finish();
+
+	return w.n_written;
+}
+
+template <typename ...Ts>
+size_t dump(const parser<Ts...> &p, char *buf, size_t size, dump_format format,
+		const std::vector<std::string_view> &positional) {
+	return dump(p, buf, size, format, &positional);
+}
+
+} // namespace conflict
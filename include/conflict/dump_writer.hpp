@@ -0,0 +1,182 @@
+#pragma once
+
+#include <string_view>
+#include <type_traits>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <cstddef>
+
+namespace conflict {
+
+enum class dump_format {
+	json,
+	key_value
+};
+
+namespace detail {
+	// Writes a dump into a fixed buffer. Output past the end of the buffer
+	// is dropped, but still counted in `n_written`.
+	struct dump_writer {
+		void raw(std::string_view str) {
+			if (n_written < size)
+				std::memcpy(buf + n_written, str.data(), std::min(str.size(), size - n_written));
+
+			n_written += str.size();
+		}
+
+		void raw(char c) {
+			raw(std::string_view{&c, 1});
+		}
+
+		void quoted(std::string_view str) {
+			constexpr char hex[] = "0123456789abcdef";
+
+			raw('"');
+
+			for (auto c : str) {
+				if (c == '"' || c == '\\') {
+					raw('\\');
+					raw(c);
+				} else if (static_cast<unsigned char>(c) < 0x20) {
+					raw("\\u00");
+					raw(hex[c >> 4]);
+					raw(hex[c & 0xF]);
+				} else {
+					raw(c);
+				}
+			}
+
+			raw('"');
+		}
+
+		// In key_value mode strings are only quoted when needed to keep one
+		// entry per line and list items apart, or to tell them from null.
+		static bool needs_quotes(std::string_view str) {
+			if (!str.size())
+				return true;
+
+			for (auto c : str) {
+				if (static_cast<unsigned char>(c) <= ' ' || c == '"' || c == '\\' || c == ',')
+					return true;
+			}
+
+			return false;
+		}
+
+		void key(std::string_view name) {
+			if (format == dump_format::json) {
+				raw(n_entries ? ',' : '{');
+				quoted(name);
+				raw(':');
+			} else {
+				raw(name);
+				raw('=');
+			}
+
+			n_entries++;
+		}
+
+		void end_entry() {
+			if (format == dump_format::key_value)
+				raw('\n');
+		}
+
+		void finish() {
+			if (format == dump_format::json)
+				raw(n_entries ? "}\n" : "{}\n");
+		}
+
+		void begin_list() {
+			if (format == dump_format::json)
+				raw('[');
+
+			in_list = true;
+			first_item = true;
+		}
+
+		void end_list() {
+			if (format == dump_format::json)
+				raw(']');
+
+			in_list = false;
+		}
+
+		void item() {
+			if (in_list && !first_item)
+				raw(',');
+
+			first_item = false;
+		}
+
+		void null() {
+			item();
+
+			if (format == dump_format::json)
+				raw("null");
+		}
+
+		void boolean(bool value) {
+			item();
+			raw(value ? "true" : "false");
+		}
+
+		void string(std::string_view value) {
+			item();
+
+			if (format == dump_format::json || needs_quotes(value))
+				quoted(value);
+			else
+				raw(value);
+		}
+
+		// JSON has no representation for NaN or infinities.
+		template <typename T>
+		void number(T value) {
+			if constexpr (std::is_floating_point_v<T>) {
+				if (format == dump_format::json && !std::isfinite(value)) {
+					null();
+					return;
+				}
+			}
+
+			char tmp[32];
+			auto [end, ec] = std::to_chars(tmp, tmp + sizeof(tmp), value);
+
+			item();
+			raw(std::string_view{tmp, static_cast<size_t>(end - tmp)});
+		}
+
+		// Values without a known representation are written as null.
+		template <typename T>
+		void value(const T &value) {
+			if constexpr (std::is_same_v<T, bool>)
+				boolean(value);
+			else if constexpr (std::is_arithmetic_v<T>)
+				number(value);
+			else if constexpr (std::is_convertible_v<const T &, std::string_view>)
+				string(value);
+			else
+				null();
+		}
+
+		char *buf;
+		size_t size;
+		dump_format format;
+
+		size_t n_written = 0;
+		size_t n_entries = 0;
+		bool in_list = false;
+		bool first_item = false;
+	};
+
+	template <typename T, typename = void>
+	struct has_dump_value : std::false_type { };
+
+	template <typename T>
+	struct has_dump_value<T, std::void_t<decltype(std::declval<const T &>().dump_value(
+		std::declval<dump_writer &>()))>> : std::true_type { };
+} // namespace detail
+
+} // namespace conflict
@@ -0,0 +1,323 @@
+#pragma once
+
+#include <string_view>
+#include <type_traits>
+#include <algorithm>
+#include <numeric>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <array>
+
+#include <conflict/error.hpp>
+#include <conflict/provenance.hpp>
+#include <conflict/detail.hpp>
+#include <conflict/traits.hpp>
+#include <conflict/fixed_vector.hpp>
+#include <conflict/help.hpp>
+#include <conflict/dump_writer.hpp>
+
+namespace conflict {
+
+namespace detail {
+	// A single option given on the command line, as handed to a
+	// dynamic_parser by a parser that doesn't know the option itself.
+	struct option_occurrence {
+		const std::vector<std::string_view> &args;
+		size_t &i;
+		std::string_view arg;
+		bool is_long;
+		std::string_view name;
+		char short_name;
+		std::string_view value;
+		bool has_value;
+		bool &consumed_value;
+		source src;
+	};
+
+	// An option owned by a dynamic_parser, with its type erased.
+	struct dynamic_entry {
+		std::unique_ptr<void, void (*)(void *)> opt;
+		option_ref ref;
+
+		status (*process_arg)(const void *opt, std::string_view arg, source src);
+		void (*set)(const void *opt, source src);
+		void (*reset)(const void *opt);
+		void (*apply_default)(const void *opt);
+
+		// Null for options without a dump_value member.
+		void (*dump_value)(const void *opt, dump_writer &w) = nullptr;
+	};
+
+	template <typename T>
+	dynamic_entry make_dynamic_entry(T opt) {
+		std::unique_ptr<void, void (*)(void *)> owned{new T(std::move(opt)), [] (void *opt) {
+			delete static_cast<T *>(opt);
+		}};
+
+		auto &typed = *static_cast<const T *>(owned.get());
+		auto ref = make_option_ref(typed);
+
+		dynamic_entry entry{std::move(owned), ref, nullptr, nullptr,
+			[] (const void *opt) {
+				detail::reset(static_cast<const T *>(opt)->target);
+			},
+			[] (const void *opt) {
+				static_cast<const T *>(opt)->apply_default();
+			}
+		};
+
+		if constexpr (T::needs_arg) {
+			entry.process_arg = [] (const void *opt, std::string_view arg, source src) {
+				return detail::process_arg(*static_cast<const T *>(opt), arg, src);
+			};
+		} else {
+			entry.set = [] (const void *opt, source src) {
+				detail::set(*static_cast<const T *>(opt), src);
+			};
+		}
+
+		if constexpr (has_dump_value<T>::value) {
+			entry.dump_value = [] (const void *opt, dump_writer &w) {
+				static_cast<const T *>(opt)->dump_value(w);
+			};
+		}
+
+		return entry;
+	}
+
+	// Sorted names (long names or groups) and the options they belong to,
+	// as kept by name_index for static parsers, built at run time.
+	struct ref_index {
+		ref_index(const std::vector<option_ref> &refs, std::string_view option_info::*key)
+		: indices(refs.size()) {
+			std::iota(indices.begin(), indices.end(), 0);
+			std::stable_sort(indices.begin(), indices.end(), [&] (size_t a, size_t b) {
+				return refs[a].info->*key < refs[b].info->*key;
+			});
+
+			for (auto i : indices)
+				names.push_back(refs[i].info->*key);
+
+			first = std::upper_bound(names.begin(), names.end(), std::string_view{}) - names.begin();
+		}
+
+		std::vector<std::string_view> names;
+		std::vector<size_t> indices;
+		size_t first;
+	};
+} // namespace detail
+
+// Options registered at run time, e.g. by plugins. Options are looked up in
+// an open-addressing hash table keyed by long name, and in a direct table
+// indexed by short name.
+//
+// A dynamic_parser is used by attaching it to a parser (parser::attach), so
+// that the static options keep their compile-time dispatch and only arguments
+// which match none of them are looked up here. A parser without static
+// options, `conflict::parser{}`, parses only the registered ones.
+struct dynamic_parser {
+	// Registers `opt`, unless one of its names is already taken, by another
+	// registered option or by an option of the parser this is attached to,
+	// in which case nothing is registered and false is returned.
+	template <typename T>
+	bool add(T opt) {
+		static_assert(is_option_v<T>, "dynamic_parser options must satisfy conflict::is_option");
+
+		auto short_opt = static_cast<unsigned char>(opt.info.short_opt);
+
+		if (short_opt && short_slots[short_opt])
+			return false;
+
+		if (opt.info.long_opt.size() && long_slots.size() && long_slots[probe(opt.info.long_opt)])
+			return false;
+
+		entries.push_back(detail::make_dynamic_entry(std::move(opt)));
+
+		auto &info = *entries.back().ref.info;
+		auto slot = static_cast<uint32_t>(entries.size());
+
+		if (short_opt)
+			short_slots[short_opt] = slot;
+
+		if (info.long_opt.size())
+			insert(info.long_opt, slot);
+
+		return true;
+	}
+
+	// Reserve the names of an option handled elsewhere, so that add()
+	// rejects them. Returns false if a registered option already uses one
+	// of them.
+	bool reserve(char short_opt, std::string_view long_opt) {
+		bool ok = true;
+
+		if (auto c = static_cast<unsigned char>(short_opt)) {
+			if (short_slots[c])
+				ok = !is_entry(short_slots[c]);
+			else
+				short_slots[c] = reserved_bit;
+		}
+
+		if (long_opt.size()) {
+			if (auto slot = long_slots.size() ? long_slots[probe(long_opt)] : 0) {
+				ok = ok && !is_entry(slot);
+			} else {
+				reserved.push_back(long_opt);
+				insert(long_opt, reserved_bit | static_cast<uint32_t>(reserved.size() - 1));
+			}
+		}
+
+		return ok;
+	}
+
+	size_t size() const {
+		return entries.size();
+	}
+
+	const detail::dynamic_entry *find(std::string_view long_opt) const {
+		if (!long_slots.size())
+			return nullptr;
+
+		auto slot = long_slots[probe(long_opt)];
+		return is_entry(slot) ? &entries[slot - 1] : nullptr;
+	}
+
+	const detail::dynamic_entry *find(char short_opt) const {
+		auto slot = short_slots[static_cast<unsigned char>(short_opt)];
+		return is_entry(slot) ? &entries[slot - 1] : nullptr;
+	}
+
+	// Process `occ` if it names one of the registered options, in which case
+	// `st` holds the outcome. Returns whether it did.
+	bool dispatch(detail::option_occurrence &occ, status &st) const {
+		auto entry = occ.is_long ? find(occ.name) : find(occ.short_name);
+
+		if (!entry)
+			return false;
+
+		if (entry->ref.needs_arg) {
+			std::string_view next_arg{};
+
+			if (occ.has_value) {
+				next_arg = occ.value;
+				occ.consumed_value = true;
+			} else {
+				if (occ.i == occ.args.size() - 1) {
+					st = status{error::missing_argument, occ.arg};
+					return true;
+				} else {
+					next_arg = occ.args[++occ.i];
+				}
+			}
+
+			st = entry->process_arg(entry->opt.get(), next_arg, occ.src);
+		} else {
+			if (occ.is_long && occ.has_value) {
+				st = status{error::invalid_argument, occ.value, entry->ref.info->long_opt};
+				return true;
+			}
+
+			entry->set(entry->opt.get(), occ.src);
+		}
+
+		return true;
+	}
+
+	void append_option_refs(std::vector<detail::option_ref> &refs) const {
+		for (auto &entry : entries)
+			refs.push_back(entry.ref);
+	}
+
+	// Write the values of the registered options, as conflict::dump does
+	// for the static ones.
+	void dump_values(detail::dump_writer &w) const {
+		for (auto &entry : entries) {
+			if (!entry.dump_value)
+				continue;
+
+			auto &info = *entry.ref.info;
+
+			w.key(info.long_opt.size() ? info.long_opt : std::string_view{&info.short_opt, 1});
+			entry.dump_value(entry.opt.get(), w);
+			w.end_entry();
+		}
+	}
+
+	// Split in two, since a parser resets the targets of its own options
+	// and of its fallback before applying any defaults.
+	void reset_targets() const {
+		for (auto &entry : entries)
+			entry.reset(entry.opt.get());
+	}
+
+	void apply_default_values() const {
+		for (auto &entry : entries)
+			entry.apply_default(entry.opt.get());
+	}
+
+	void apply_defaults() const {
+		reset_targets();
+		apply_default_values();
+	}
+
+private:
+	static constexpr uint32_t reserved_bit = uint32_t{1} << 31;
+
+	static bool is_entry(uint32_t slot) {
+		return slot && !(slot & reserved_bit);
+	}
+
+	std::string_view slot_name(uint32_t slot) const {
+		return slot & reserved_bit ? reserved[slot & ~reserved_bit] : entries[slot - 1].ref.info->long_opt;
+	}
+
+	// The slot holding `name`, or the empty slot where it would go.
+	size_t probe(std::string_view name) const {
+		detail::fnv1a h;
+		h.add(name);
+
+		size_t mask = long_slots.size() - 1;
+
+		for (size_t pos = h.hash & mask;; pos = (pos + 1) & mask) {
+			auto slot = long_slots[pos];
+
+			if (!slot || slot_name(slot) == name)
+				return pos;
+		}
+	}
+
+	void insert(std::string_view name, uint32_t slot) {
+		// Keep the table at most half full, so that probe sequences stay short.
+		if ((n_long + 1) * 2 > long_slots.size())
+			rehash(std::max<size_t>(16, long_slots.size() * 2));
+
+		long_slots[probe(name)] = slot;
+		n_long++;
+	}
+
+	void rehash(size_t capacity) {
+		std::vector<uint32_t> old(capacity, 0);
+		old.swap(long_slots);
+
+		for (auto slot : old) {
+			if (slot)
+				long_slots[probe(slot_name(slot))] = slot;
+		}
+	}
+
+	std::vector<detail::dynamic_entry> entries;
+
+	// Names reserved for options handled elsewhere.
+	std::vector<std::string_view> reserved;
+
+	// Entry indices plus one, reserved name indices with reserved_bit set,
+	// or zero for empty slots.
+	std::vector<uint32_t> long_slots;
+	std::array<uint32_t, 256> short_slots{};
+	size_t n_long = 0;
+};
+
+} // namespace conflict
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <string_view>
+#include <cstddef>
+#include <cstdlib>
 
 #include <iostream>
 
@@ -10,7 +12,12 @@ enum class error {
 	ok,
 	invalid_option,
 	invalid_argument,
-	missing_argument
+	missing_argument,
+	ambiguous_option,
+	too_many_values,
+	missing_option,
+	conflicting_options,
+	missing_dependency
 };
 
 struct status {
@@ -18,6 +25,10 @@ struct status {
 	std::string_view what1 = {};
 	std::string_view what2 = {};
 
+	// Possible matches for an ambiguous option.
+	const std::string_view *candidates = nullptr;
+	size_t n_candidates = 0;
+
 	operator bool() const {
 		return err == error::ok;
 	}
@@ -38,6 +49,24 @@ inline void default_report(status st) {
 		case error::missing_argument:
 			std::cerr << "Missing argument for \"" << st.what1 << "\"\n";
 			break;
+		case error::ambiguous_option:
+			std::cerr << "Ambiguous option \"" << st.what1 << "\", could be:";
+			for (size_t i = 0; i < st.n_candidates; i++)
+				std::cerr << (i ? ", --" : " --") << st.candidates[i];
+			std::cerr << "\n";
+			break;
+		case error::too_many_values:
+			std::cerr << "Too many values for \"" << st.what2 << "\"\n";
+			break;
+		case error::missing_option:
+			std::cerr << "Missing required option \"" << st.what1 << "\"\n";
+			break;
+		case error::conflicting_options:
+			std::cerr << "Option \"" << st.what1 << "\" conflicts with \"" << st.what2 << "\"\n";
+			break;
+		case error::missing_dependency:
+			std::cerr << "Option \"" << st.what1 << "\" requires \"" << st.what2 << "\"\n";
+			break;
 		default:
 			std::cerr << "Invalid error in conflict::default_report\n";
 	}
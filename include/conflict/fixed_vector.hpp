@@ -0,0 +1,66 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <cstddef>
+
+namespace conflict {
+
+// Vector with a fixed capacity and inline storage, for collecting
+// repeated option values without allocating.
+template <typename T, size_t N>
+struct fixed_vector {
+	bool try_push_back(const T &value) {
+		if (n_items == N)
+			return false;
+
+		items[n_items++] = value;
+		return true;
+	}
+
+	void clear() {
+		n_items = 0;
+	}
+
+	size_t size() const { return n_items; }
+	static constexpr size_t capacity() { return N; }
+	bool empty() const { return !n_items; }
+
+	T &operator[](size_t i) { return items[i]; }
+	const T &operator[](size_t i) const { return items[i]; }
+
+	T *begin() { return items.data(); }
+	T *end() { return items.data() + n_items; }
+	const T *begin() const { return items.data(); }
+	const T *end() const { return items.data() + n_items; }
+
+	std::array<T, N> items{};
+	size_t n_items = 0;
+};
+
+namespace detail {
+	template <typename T>
+	bool append(std::vector<T> &target, const T &value) {
+		target.push_back(value);
+		return true;
+	}
+
+	template <typename T, size_t N>
+	bool append(fixed_vector<T, N> &target, const T &value) {
+		return target.try_push_back(value);
+	}
+
+	// Reset an option target to its empty state, before defaults are applied.
+	template <typename T>
+	void reset(T &target) {
+		target = T{};
+	}
+
+	// Avoids building (and copying) a whole fixed_vector temporary.
+	template <typename T, size_t N>
+	void reset(fixed_vector<T, N> &target) {
+		target.clear();
+	}
+} // namespace detail
+
+} // namespace conflict
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <string_view>
+#include <type_traits>
+#include <algorithm>
+#include <iostream>
+#include <utility>
+#include <cstddef>
+#include <vector>
+
+#include <conflict/info.hpp>
+#include <conflict/detail.hpp>
+
+namespace conflict::detail {
+	template <typename T, typename = void>
+	struct has_placeholder : std::false_type { };
+
+	template <typename T>
+	struct has_placeholder<T, std::void_t<decltype(T::placeholder)>> : std::true_type { };
+
+	template <typename T, typename = void>
+	struct has_hash_help : std::false_type { };
+
+	template <typename T>
+	struct has_hash_help<T, std::void_t<decltype(std::declval<const T &>().hash_help(
+		std::declval<fnv1a &>()))>> : std::true_type { };
+
+	// Type-erased view of an option, used on cold paths (help output,
+	// completion) so that they are compiled once instead of once per parser.
+	struct option_ref {
+		using completion_fn = void (*)(void *ctx, std::string_view head, std::string_view value);
+
+		const void *opt;
+		const option_info *info;
+		bool needs_arg;
+		std::string_view argument_name;
+
+		void (*print_argument_placeholder)(const void *opt, line_printer &pr);
+		void (*print_extra)(const void *opt, line_printer &pr);
+		void (*complete_arg)(const void *opt, std::string_view word, completion_fn fn, void *ctx);
+
+		// Null for options whose help output depends only on `info`.
+		void (*hash_help)(const void *opt, fnv1a &h);
+	};
+
+	template <typename T>
+	option_ref make_option_ref(const T &opt) {
+		std::string_view argument_name;
+
+		if constexpr (has_placeholder<T>::value)
+			argument_name = opt.placeholder;
+		else
+			argument_name = opt.info.long_opt;
+
+		void (*hash_help)(const void *, fnv1a &) = nullptr;
+
+		if constexpr (has_hash_help<T>::value) {
+			hash_help = [] (const void *opt, fnv1a &h) {
+				static_cast<const T *>(opt)->hash_help(h);
+			};
+		}
+
+		return option_ref{
+			&opt, &opt.info, T::needs_arg, argument_name,
+			[] (const void *opt, line_printer &pr) {
+				static_cast<const T *>(opt)->print_argument_placeholder(pr);
+			},
+			[] (const void *opt, line_printer &pr) {
+				static_cast<const T *>(opt)->print_extra(pr);
+			},
+			[] (const void *opt, std::string_view word, option_ref::completion_fn fn, void *ctx) {
+				static_cast<const T *>(opt)->complete_arg(word,
+					[&] (std::string_view head, std::string_view value) {
+						fn(ctx, head, value);
+					});
+			},
+			hash_help
+		};
+	}
+
+	template <typename F>
+	void complete_arg(const option_ref &ref, std::string_view word, F &&fn) {
+		ref.complete_arg(ref.opt, word, [] (void *ctx, std::string_view head, std::string_view value) {
+			(*static_cast<std::remove_reference_t<F> *>(ctx))(head, value);
+		}, const_cast<void *>(static_cast<const void *>(&fn)));
+	}
+
+	inline void print_option(std::ostream &out, const option_ref &opt, size_t space) {
+		line_printer pr{out, space};
+
+		pr.print("    ");
+		if (opt.info->short_opt) {
+			pr.print('-', opt.info->short_opt);
+
+			if (opt.info->long_opt.size()) {
+				pr.print('/');
+			}
+		}
+
+		if (opt.info->long_opt.size()) {
+			pr.print("--", opt.info->long_opt);
+		}
+
+		opt.print_argument_placeholder(opt.opt, pr);
+
+		if (opt.info->desc.size()) {
+			pr.pad();
+			out << opt.info->desc;
+		}
+
+		out << "\n";
+
+		opt.print_extra(opt.opt, pr);
+	}
+
+	// Print the visible options among `opts[indices[lo, hi)]`, under a
+	// header unless `group` is empty, and preceded by an empty line if
+	// `separate` is set. Returns whether anything was printed.
+	inline bool print_section(std::ostream &out, const option_ref *opts, std::string_view group, const size_t *indices,
+			size_t lo, size_t hi, size_t space, bool separate = false) {
+		while (lo < hi && opts[indices[lo]].info->hidden)
+			lo++;
+
+		if (lo == hi)
+			return false;
+
+		if (separate)
+			out << "\n";
+
+		if (group.size())
+			out << group << ":\n";
+
+		for (size_t i = lo; i < hi; i++) {
+			if (!opts[indices[i]].info->hidden)
+				print_option(out, opts[indices[i]], space);
+		}
+
+		return true;
+	}
+
+	// `groups` are the sorted group names, with the first `first` being
+	// empty, and `indices` the options they belong to. Ungrouped options
+	// are printed first, then each group in the order it first appears.
+	inline void print_help(std::ostream &out, const option_ref *opts, const std::string_view *groups, const size_t *indices,
+			size_t first, size_t n, size_t space) {
+		bool printed = print_section(out, opts, {}, indices, 0, first, space);
+
+		std::vector<std::pair<size_t, size_t>> sections;
+
+		for (size_t lo = first, hi; lo < n; lo = hi) {
+			for (hi = lo + 1; hi < n && groups[hi] == groups[lo]; hi++)
+				;
+
+			sections.emplace_back(lo, hi);
+		}
+
+		std::sort(sections.begin(), sections.end(), [&] (auto &a, auto &b) {
+			return indices[a.first] < indices[b.first];
+		});
+
+		for (auto [lo, hi] : sections) {
+			if (print_section(out, opts, groups[lo], indices, lo, hi, space, printed))
+				printed = true;
+		}
+	}
+} // namespace conflict::detail
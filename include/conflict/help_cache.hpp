@@ -0,0 +1,181 @@
+#pragma once
+
+#include <string_view>
+#include <system_error>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <chrono>
+#include <sstream>
+#include <cstdlib>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+#include <conflict/help.hpp>
+#include <conflict/parser.hpp>
+
+namespace conflict {
+
+// Opt-in cache for the help output of a parser with many options. The output
+// is rendered once and kept here, keyed by a hash of the option table and the
+// layout, and may additionally be persisted across runs.
+struct help_cache {
+	// If set, the output is also stored in $XDG_CACHE_HOME/<name>/ (or in
+	// ~/.cache/<name>/), and read back from there by later runs.
+	std::string_view name = {};
+
+	// Mixed into the key, which otherwise covers everything the built-in
+	// options print. Custom options without a `hash_help` member (see
+	// conflict::is_option) are keyed only by their info, so persisted caches
+	// should set this to something that changes with the program.
+	std::string_view version = {};
+
+	uint64_t key = 0;
+	std::string text = {};
+	bool valid = false;
+};
+
+namespace detail {
+	inline uint64_t help_key(const option_ref *opts, size_t n, size_t space, std::string_view version) {
+		fnv1a h;
+
+		h.add(version);
+		h.add(space);
+		h.add(n);
+
+		for (size_t i = 0; i < n; i++) {
+			auto &info = *opts[i].info;
+
+			h.add_byte(info.short_opt);
+			h.add(info.long_opt);
+			h.add(info.desc);
+			h.add(info.group);
+			h.add_byte(info.hidden);
+			h.add_byte(opts[i].needs_arg);
+			h.add(opts[i].argument_name);
+
+			if (opts[i].hash_help)
+				opts[i].hash_help(opts[i].opt, h);
+		}
+
+		return h.hash;
+	}
+
+	inline void append_hex(std::string &str, uint64_t value) {
+		constexpr char hex[] = "0123456789abcdef";
+
+		for (size_t i = 16; i-- > 0;)
+			str += hex[(value >> (i * 4)) & 0xf];
+	}
+
+	// Empty if there is nowhere to persist the output.
+	inline std::filesystem::path help_cache_path(std::string_view name, uint64_t key) {
+		std::filesystem::path base;
+
+		if (auto xdg = std::getenv("XDG_CACHE_HOME"); xdg && *xdg)
+			base = xdg;
+		else if (auto home = std::getenv("HOME"); home && *home)
+			base = std::filesystem::path{home} / ".cache";
+		else
+			return {};
+
+		std::string file = "help-";
+		append_hex(file, key);
+
+		return base / name / file;
+	}
+
+	inline bool load_help(help_cache &cache) {
+		auto path = help_cache_path(cache.name, cache.key);
+
+		if (path.empty())
+			return false;
+
+		std::ifstream in{path, std::ios::binary};
+		if (!in)
+			return false;
+
+		std::ostringstream text;
+		if (!(text << in.rdbuf()))
+			return false;
+
+		cache.text = text.str();
+		return true;
+	}
+
+	// Failing to persist the output is not an error, it is just rendered
+	// again by the next run. The file is written under a temporary name
+	// unique to this writer first, so that neither an interrupted write nor
+	// concurrent runs writing the same entry leave a corrupt file behind.
+	inline void store_help(const help_cache &cache) {
+		auto path = help_cache_path(cache.name, cache.key);
+
+		if (path.empty())
+			return;
+
+		std::error_code ec;
+		std::filesystem::create_directories(path.parent_path(), ec);
+		if (ec)
+			return;
+
+		std::random_device random;
+		auto nonce = (uint64_t{random()} << 32 | random())
+			^ static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+
+		std::string suffix = ".tmp-";
+		append_hex(suffix, nonce);
+
+		auto tmp = path;
+		tmp += suffix;
+
+		std::ofstream out{tmp, std::ios::binary};
+		out << cache.text;
+		out.close();
+
+		if (!out) {
+			std::filesystem::remove(tmp, ec);
+			return;
+		}
+
+		std::filesystem::rename(tmp, path, ec);
+		if (ec)
+			std::filesystem::remove(tmp, ec);
+	}
+
+	// The help output for `opts`, rendered only if `cache` doesn't already
+	// hold it. Arguments are as for print_help.
+	inline const std::string &cached_help(help_cache &cache, const option_ref *opts,
+			const std::string_view *groups, const size_t *indices, size_t first, size_t n, size_t space) {
+		auto key = help_key(opts, n, space, cache.version);
+
+		if (cache.valid && cache.key == key)
+			return cache.text;
+
+		cache.key = key;
+		cache.valid = true;
+
+		if (cache.name.size() && load_help(cache))
+			return cache.text;
+
+		std::ostringstream out;
+		print_help(out, opts, groups, indices, first, n, space);
+		cache.text = out.str();
+
+		if (cache.name.size())
+			store_help(cache);
+
+		return cache.text;
+	}
+} // namespace detail
+
+// Print the help output of `p`, rendering it only if `cache` doesn't
+// already hold it. Costs nothing for programs which don't use a cache.
+template <typename ...Ts>
+void print_help(const parser<Ts...> &p, help_cache &cache) {
+	p.help_table([&] (auto ...table) {
+		std::cout << detail::cached_help(cache, table..., p.space);
+	});
+}
+
+} // namespace conflict
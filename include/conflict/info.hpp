@@ -11,9 +11,26 @@ struct option_info {
 	constexpr option_info(std::string_view long_opt, std::string_view desc = {})
 	: short_opt{0}, long_opt{long_opt}, desc{desc} { }
 
+	// Lists the option under its own section of the help output.
+	constexpr option_info in_group(std::string_view name) const {
+		auto copy = *this;
+		copy.group = name;
+		return copy;
+	}
+
+	// Leaves the option out of the help output. It is still parsed as usual.
+	constexpr option_info hide() const {
+		auto copy = *this;
+		copy.hidden = true;
+		return copy;
+	}
+
 	char short_opt;
 	std::string_view long_opt;
 	std::string_view desc;
+
+	std::string_view group = {};
+	bool hidden = false;
 };
 
 } // namespace conflict
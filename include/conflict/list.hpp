@@ -0,0 +1,63 @@
+#pragma once
+
+#include <vector>
+#include <string_view>
+#include <conflict/info.hpp>
+#include <conflict/detail.hpp>
+#include <conflict/error.hpp>
+#include <conflict/value.hpp>
+#include <conflict/fixed_vector.hpp>
+
+namespace conflict {
+
+template <typename T, typename Container = std::vector<T>>
+struct list_option {
+	static constexpr bool needs_arg = true;
+
+	option_info info;
+
+	std::string_view placeholder;
+
+	Container &target;
+
+	void print_argument_placeholder(detail::line_printer &pr) const {
+		pr.print(" <", placeholder, ">");
+	}
+
+	void print_extra(detail::line_printer &) const { }
+
+	template <typename F>
+	void complete_arg(std::string_view, F &&) const { }
+
+	template <typename W>
+	void dump_value(W &w) const {
+		w.begin_list();
+
+		for (auto &value : target)
+			w.value(value);
+
+		w.end_list();
+	}
+
+	void apply_default() const {}
+
+	status process_arg(std::string_view arg) const {
+		T value{};
+
+		if (!value_parser<T>::parse(arg, value))
+			return status{error::invalid_argument, arg, info.long_opt};
+
+		if (!detail::append(target, value))
+			return status{error::too_many_values, arg, info.long_opt};
+
+		return status{};
+	}
+};
+
+template <typename T>
+list_option(option_info, std::string_view, std::vector<T> &) -> list_option<T>;
+
+template <typename T, size_t N>
+list_option(option_info, std::string_view, fixed_vector<T, N> &) -> list_option<T, fixed_vector<T, N>>;
+
+} // namespace conflict
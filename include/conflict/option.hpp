@@ -1,8 +1,10 @@
 #pragma once
 
 #include <cstdint>
+#include <string_view>
 #include <conflict/info.hpp>
 #include <conflict/detail.hpp>
+#include <conflict/provenance.hpp>
 
 namespace conflict {
 
@@ -17,15 +19,57 @@ struct option {
 	uint64_t flag_bit;
 	bool set_by_default = false;
 
+	// Optionally records where the bit was set from.
+	provenance *origin = nullptr;
+
 	void print_argument_placeholder(detail::line_printer &) const { }
 	void print_extra(detail::line_printer &) const { }
 
+	template <typename F>
+	void complete_arg(std::string_view, F &&) const { }
+
+	template <typename W>
+	void dump_value(W &w) const {
+		w.boolean((target & flag_bit) == flag_bit);
+	}
+
 	void apply_default() const {
 		target |= set_by_default ? flag_bit : 0;
+
+		if (origin)
+			origin->record(flag_bit, set_by_default ? source::defaults : source::none);
 	}
 
-	void set() const {
+	void set(source src = source::argv) const {
 		target |= flag_bit;
+
+		if (origin)
+			origin->record(flag_bit, src);
+	}
+};
+
+struct counter_option {
+	static constexpr bool needs_arg = false;
+
+	option_info info;
+
+	uint64_t &target;
+
+	void print_argument_placeholder(detail::line_printer &) const { }
+	void print_extra(detail::line_printer &) const { }
+
+	template <typename F>
+	void complete_arg(std::string_view, F &&) const { }
+
+	template <typename W>
+	void dump_value(W &w) const {
+		w.number(target);
+	}
+
+	void apply_default() const { }
+
+	void set() const {
+		target++;
 	}
 };
 
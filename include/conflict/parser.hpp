@@ -1,93 +1,282 @@
 #pragma once
 
-#include <tuple>
+#include <array>
 #include <vector>
 #include <cstddef>
+#include <cstdint>
 #include <iostream>
+#include <initializer_list>
 #include <string_view>
-#include <variant>
 
 #include <conflict/error.hpp>
+#include <conflict/constraint.hpp>
 #include <conflict/detail.hpp>
+#include <conflict/traits.hpp>
+#include <conflict/fixed_vector.hpp>
+#include <conflict/help.hpp>
+#include <conflict/dynamic.hpp>
 
 namespace conflict {
 
 template <typename ...Ts>
 struct parser {
-	parser(Ts ...ts)
-	: options{std::make_tuple(ts...)} { }
+	static_assert((is_option_v<Ts> && ...), "parser options must satisfy conflict::is_option");
+
+	constexpr parser(Ts ...ts)
+	: options{ts...},
+		long_index{std::array<std::string_view, sizeof...(Ts)>{ts.info.long_opt...}},
+		group_index{std::array<std::string_view, sizeof...(Ts)>{ts.info.group...}} {
+		validate();
+	}
 
 	static constexpr size_t space = 32;
 
-	void print_help() const {
-		auto print_option = [&] (const auto &opt) {
-			detail::line_printer pr{parser::space};
+	// The set of options given, for check_constraints.
+	using option_set = detail::option_mask<sizeof...(Ts)>;
+
+	// Accept unambiguous prefixes of long option names, e.g. --verb for --verbose.
+	bool allow_abbreviations = false;
+
+	// If set, options matching none of the static ones are looked up here.
+	// Set by attach.
+	const dynamic_parser *fallback = nullptr;
 
-			pr.print("    ");
-			if (opt.info.short_opt) {
-				pr.print('-', opt.info.short_opt);
+	// Make `d` the fallback, reserving the names of the static options in it
+	// so that dynamic_parser::add rejects them. Returns false if an option
+	// registered earlier uses one of them, since it could never match.
+	bool attach(dynamic_parser &d) {
+		bool ok = true;
 
-				if (opt.info.long_opt.size()) {
-					pr.print('/');
+		for (auto &ref : option_refs())
+			ok = d.reserve(ref.info->short_opt, ref.info->long_opt) && ok;
+
+		fallback = &d;
+		return ok;
+	}
+
+	constexpr void validate() const {
+		constexpr size_t n = sizeof...(Ts);
+
+		auto &names = long_index.names;
+		for (size_t i = long_index.first + 1; i < n; i++) {
+			if (names[i] == names[i - 1])
+				detail::invalid_configuration("duplicate long option name");
+		}
+
+		std::array<bool, 256> seen_shorts{};
+		std::array<const uint64_t *, n> targets{};
+		std::array<uint64_t, n> bits{};
+		size_t n_flags = 0;
+
+		options.apply([&] (const auto &...ts) {
+			([&] (const auto &opt) {
+				if (auto c = static_cast<unsigned char>(opt.info.short_opt)) {
+					if (seen_shorts[c])
+						detail::invalid_configuration("duplicate short option name");
+					seen_shorts[c] = true;
 				}
-			}
 
-			if (opt.info.long_opt.size()) {
-				pr.print("--", opt.info.long_opt);
+				using type = std::decay_t<decltype(opt)>;
+
+				// Choices claim all the bits of their flags at once.
+				if constexpr (detail::has_flag_bit<type>::value) {
+					targets[n_flags] = &opt.target;
+					bits[n_flags] = opt.flag_bit;
+					n_flags++;
+				} else if constexpr (detail::has_all_bits<type>::value) {
+					targets[n_flags] = &opt.target;
+					bits[n_flags] = opt.all_bits();
+					n_flags++;
+				}
+			}(ts), ...);
+		});
+
+		for (size_t i = 0; i < n_flags; i++) {
+			for (size_t j = 0; j < i; j++) {
+				if (targets[i] == targets[j] && (bits[i] & bits[j]))
+					detail::invalid_configuration("overlapping flag bits for the same target");
 			}
+		}
+	}
 
-			opt.print_argument_placeholder(pr);
+	// A copy of this parser with `constraints` added, resolved into masks
+	// and option indices. Checked by check_constraints.
+	constexpr parser constrain(std::initializer_list<constraint> constraints) const {
+		auto copy = *this;
 
-			if (opt.info.desc.size()) {
-				pr.pad();
-				std::cout << opt.info.desc;
-			}
+		for (auto &c : constraints)
+			copy.add_constraint(c);
+
+		return copy;
+	}
 
-			std::cout << "\n";
+	constexpr void add_constraint(const constraint &c) {
+		constexpr size_t n = sizeof...(Ts);
 
-			opt.print_extra(pr);
+		auto resolve = [&] (std::string_view name) {
+			auto index = long_index.find(name);
+
+			if (index == n)
+				detail::invalid_configuration("constraint refers to an unknown option");
+
+			return index;
 		};
 
-		std::apply([&] (const auto &...ts) {
-			(print_option(ts), ...);
-		}, options);
+		auto i = resolve(c.option);
+
+		if (c.other.size() && resolve(c.other) == i)
+			detail::invalid_configuration("option constrains itself");
+
+		switch (c.type) {
+			case constraint::kind::required:
+				required.set(i);
+				if (c.other.size())
+					unless[i] = resolve(c.other);
+				break;
+			case constraint::kind::conflicts:
+				has_conflict.set(i);
+				conflicts[i].set(resolve(c.other));
+				break;
+			case constraint::kind::depends:
+				has_dependency.set(i);
+				depends[i].set(resolve(c.other));
+				break;
+		}
+	}
+
+	// Name of the option at `index`, for error reporting.
+	std::string_view option_name(size_t index) const {
+		auto refs = option_refs();
+		auto &info = *refs[index].info;
+
+		return info.long_opt.size() ? info.long_opt : std::string_view{&info.short_opt, 1};
+	}
+
+	// Check the constraints of all options against the ones given, as
+	// collected by one or more calls to parse. This is separate from
+	// parsing, so that e.g. --help can be acted upon first, and so that
+	// arguments from several sources are checked together.
+	status check_constraints(const option_set &seen) const {
+		constexpr size_t n = sizeof...(Ts);
+		status st{};
+
+		(required & ~seen).for_each([&] (size_t i) {
+			if (st && (unless[i] == n || !seen.test(unless[i])))
+				st = status{error::missing_option, option_name(i)};
+		});
+
+		(has_conflict & seen).for_each([&] (size_t i) {
+			(conflicts[i] & seen).for_each([&] (size_t j) {
+				if (st)
+					st = status{error::conflicting_options, option_name(i), option_name(j)};
+			});
+		});
+
+		(has_dependency & seen).for_each([&] (size_t i) {
+			(depends[i] & ~seen).for_each([&] (size_t j) {
+				if (st)
+					st = status{error::missing_dependency, option_name(i), option_name(j)};
+			});
+		});
+
+		return st;
+	}
+
+	std::array<detail::option_ref, sizeof...(Ts)> option_refs() const {
+		return options.apply([] (const auto &...ts) {
+			return std::array<detail::option_ref, sizeof...(Ts)>{detail::make_option_ref(ts)...};
+		});
+	}
+
+	// Call `fn` with the options listed in help output, including those of
+	// the fallback, along with their groups, as taken by detail::print_help.
+	template <typename F>
+	decltype(auto) help_table(F &&fn) const {
+		auto refs = option_refs();
+
+		if (fallback) {
+			std::vector<detail::option_ref> all{refs.begin(), refs.end()};
+			fallback->append_option_refs(all);
+
+			detail::ref_index groups{all, &option_info::group};
+			return fn(all.data(), groups.names.data(), groups.indices.data(), groups.first, all.size());
+		}
+
+		return fn(refs.data(), group_index.names.data(), group_index.indices.data(),
+			group_index.first, refs.size());
+	}
+
+	void print_help() const {
+		help_table([&] (auto ...table) {
+			detail::print_help(std::cout, table..., space);
+		});
+	}
+
+	// Print only the options in `group`, e.g. for --help=group. Returns
+	// whether the group has any visible options.
+	bool print_help(std::string_view group) const {
+		return help_table([&] (const detail::option_ref *refs, const std::string_view *groups,
+				const size_t *indices, size_t, size_t n) {
+			auto [lo, hi] = detail::equal_range(groups, n, group);
+			return detail::print_section(std::cout, refs, group, indices, lo, hi, space);
+		});
 	}
 
 	void apply_defaults() const {
-		std::apply([&] (const auto &...ts) {
-			((ts.target = std::decay_t<decltype(ts.target)>{}), ...);
-		}, options);
+		options.apply([&] (const auto &...ts) {
+			(detail::reset(ts.target), ...);
+		});
+
+		if (fallback)
+			fallback->reset_targets();
 
-		std::apply([&] (const auto &...ts) {
+		options.apply([&] (const auto &...ts) {
 			(ts.apply_default(), ...);
-		}, options);
+		});
+
+		if (fallback)
+			fallback->apply_default_values();
 	}
 
-	status parse(int argc, char **argv, std::vector<std::string_view> &positional) const {
+	status parse(int argc, char **argv, std::vector<std::string_view> &positional,
+			option_set *seen = nullptr) const {
 		std::vector<std::string_view> args{argv, argv + argc};
-		return parse(args, &positional);
+		return parse(args, &positional, source::argv, seen);
 	}
 
-	status parse(int argc, char **argv, std::vector<std::string_view> *positional = nullptr) const {
+	status parse(int argc, char **argv, std::vector<std::string_view> *positional = nullptr,
+			option_set *seen = nullptr) const {
 		std::vector<std::string_view> args{argv, argv + argc};
-		return parse(args, positional);
+		return parse(args, positional, source::argv, seen);
 	}
 
-	status parse(int argc, const char **argv, std::vector<std::string_view> &positional) const {
+	status parse(int argc, const char **argv, std::vector<std::string_view> &positional,
+			option_set *seen = nullptr) const {
 		std::vector<std::string_view> args{argv, argv + argc};
-		return parse(args, &positional);
+		return parse(args, &positional, source::argv, seen);
 	}
 
-	status parse(int argc, const char **argv, std::vector<std::string_view> *positional = nullptr) const {
+	status parse(int argc, const char **argv, std::vector<std::string_view> *positional = nullptr,
+			option_set *seen = nullptr) const {
 		std::vector<std::string_view> args{argv, argv + argc};
-		return parse(args, positional);
+		return parse(args, positional, source::argv, seen);
 	}
 
-	status parse(const std::vector<std::string_view> &args, std::vector<std::string_view> &positional) const {
-		return parse(args, &positional);
+	status parse(const std::vector<std::string_view> &args, std::vector<std::string_view> &positional,
+			source src = source::argv, option_set *seen = nullptr) const {
+		return parse(args, &positional, src, seen);
 	}
 
-	status parse(const std::vector<std::string_view> &args, std::vector<std::string_view> *positional = nullptr) const {
+	// `src` is recorded as the origin of the settings made, by options
+	// which track provenance. The options given are added to `seen`, if
+	// set, for check_constraints.
+	status parse(const std::vector<std::string_view> &args, std::vector<std::string_view> *positional = nullptr,
+			source src = source::argv, option_set *seen = nullptr) const {
+		option_set unused{};
+
+		if (!seen)
+			seen = &unused;
+
 		auto parse_arg = [&] (size_t &i) -> status {
 			auto arg = args[i];
 
@@ -96,59 +285,116 @@ struct parser {
 
 			bool is_long = arg[1] == '-';
 
-			auto process_opt = [&] (const auto &opt) -> std::variant<bool, status> {
-				if (!is_long && !opt.info.short_opt)
-					return false;
+			std::string_view name{};
+			char short_name = 0;
+			std::string_view value{};
+			bool has_value = false;
+			bool consumed_value = false;
 
-				if (!is_long && arg[1] != opt.info.short_opt)
-					return false;
+			if (is_long) {
+				auto eq = arg.find('=');
 
-				if (is_long && arg.substr(2, opt.info.long_opt.size()) != opt.info.long_opt)
-					return false;
+				name = arg.substr(2, eq == std::string_view::npos ? eq : eq - 2);
 
-				if (is_long && arg.size() != opt.info.long_opt.size() + 2
-						&& (arg.size() <= opt.info.long_opt.size() + 2
-							&& arg[2 + opt.info.long_opt.size()] != '='))
+				if (eq != std::string_view::npos) {
+					value = arg.substr(eq + 1);
+					has_value = true;
+				}
+
+				if (!name.size())
+					return status{error::invalid_option, arg};
+
+				// Exact names of fallback options are never taken as abbreviations.
+				if (allow_abbreviations && !(fallback && fallback->find(name))) {
+					auto [lo, hi] = long_index.prefix_range(name);
+
+					if (lo == hi)
+						return status{error::invalid_option, arg};
+
+					// An exact match always sorts first among the names it prefixes.
+					if (long_index.names[lo] != name && hi - lo > 1) {
+						status st{error::ambiguous_option, arg};
+						st.candidates = &long_index.names[lo];
+						st.n_candidates = hi - lo;
+						return st;
+					}
+
+					name = long_index.names[lo];
+				}
+			}
+
+			status st{};
+
+			// Returns whether `opt` matched the argument, in which case `st`
+			// holds the outcome of processing it. `index` is passed at run
+			// time, so that this is instantiated once per option type.
+			auto process_opt = [&] (const auto &opt, size_t index) -> bool {
+				if (is_long ? name != opt.info.long_opt
+						: !opt.info.short_opt || short_name != opt.info.short_opt)
 					return false;
 
 				if constexpr (std::decay_t<decltype(opt)>::needs_arg) {
 					std::string_view next_arg{};
 
-					if (is_long && arg[2 + opt.info.long_opt.size()] == '=') {
-						next_arg = arg.substr(3 + opt.info.long_opt.size());
+					if (has_value) {
+						next_arg = value;
+						consumed_value = true;
 					} else {
 						if (i == args.size() - 1) {
-							return status{error::missing_argument, arg};
+							st = status{error::missing_argument, arg};
+							return true;
 						} else {
 							next_arg = args[++i];
 						}
 					}
 
-					return opt.process_arg(next_arg);
+					st = detail::process_arg(opt, next_arg, src);
 				} else {
-					opt.set();
+					if (is_long && has_value) {
+						st = status{error::invalid_argument, value, opt.info.long_opt};
+						return true;
+					}
 
-					return arg.back() != '=';
+					detail::set(opt, src);
 				}
 
+				seen->set(index);
 				return true;
 			};
 
-			return std::apply([&] (const auto &...ts) -> status {
-				status st{};
-				std::variant<bool, status> ret{};
+			// Stops probing options at the first one that matches.
+			auto dispatch = [&] {
+				bool matched = options.apply_leaves([&] (const auto &...leaves) {
+					return (process_opt(leaves.value, leaves.index) || ...);
+				});
 
-				bool ok = (((ret = process_opt(ts)),
-					std::holds_alternative<status>(ret)
-						? ((st = std::get<status>(ret)), false)
-						: !std::get<bool>(ret)
-					) && ...);
+				if (!matched && fallback) {
+					detail::option_occurrence occ{args, i, arg, is_long, name, short_name,
+						value, has_value, consumed_value, src};
+					matched = fallback->dispatch(occ, st);
+				}
 
-				if (ok && st)
+				if (!matched)
 					st = status{error::invalid_option, arg};
 
 				return st;
-			}, options);
+			};
+
+			if (is_long)
+				return dispatch();
+
+			// Short options may be bundled (-vvv), in which case an option
+			// that takes an argument consumes the rest of the bundle (-ofile).
+			for (size_t j = 1; j < arg.size() && !consumed_value; j++) {
+				short_name = arg[j];
+				value = arg.substr(j + 1);
+				has_value = value.size();
+
+				if (auto st = dispatch(); !st)
+					return st;
+			}
+
+			return status{};
 		};
 
 		for (size_t i = 0; i < args.size(); i++) {
@@ -169,7 +415,30 @@ struct parser {
 		return status{};
 	}
 
-	std::tuple<Ts...> options;
+	detail::option_list<Ts...> options;
+	detail::name_index<sizeof...(Ts)> long_index;
+	detail::name_index<sizeof...(Ts)> group_index;
+
+	detail::option_mask<sizeof...(Ts)> required{};
+	detail::option_mask<sizeof...(Ts)> has_conflict{};
+	detail::option_mask<sizeof...(Ts)> has_dependency{};
+
+	// For each option, the index of the option named by `unless`, or the
+	// number of options if none.
+	std::array<size_t, sizeof...(Ts)> unless = filled_indices();
+
+	// For each option, the options it conflicts with or depends on.
+	std::array<detail::option_mask<sizeof...(Ts)>, sizeof...(Ts)> conflicts{};
+	std::array<detail::option_mask<sizeof...(Ts)>, sizeof...(Ts)> depends{};
+
+	static constexpr std::array<size_t, sizeof...(Ts)> filled_indices() {
+		std::array<size_t, sizeof...(Ts)> indices{};
+
+		for (auto &index : indices)
+			index = sizeof...(Ts);
+
+		return indices;
+	}
 };
 
 template <typename ...Ts>
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+namespace conflict {
+
+// Where a setting came from.
+enum class source : uint8_t {
+	none,
+	defaults,
+	env,
+	file,
+	argv
+};
+
+inline std::string_view source_name(source src) {
+	switch (src) {
+		case source::none: return "none";
+		case source::defaults: return "default";
+		case source::env: return "env";
+		case source::file: return "file";
+		case source::argv: return "argv";
+	}
+
+	return "unknown";
+}
+
+// Records which source last wrote each bit of a target word. Each bit is
+// set in at most one of the masks.
+struct provenance {
+	void record(uint64_t mask, source src) {
+		for (auto &bits : masks)
+			bits &= ~mask;
+
+		if (src != source::none)
+			masks[static_cast<size_t>(src) - 1] |= mask;
+	}
+
+	source of(uint64_t bit) const {
+		for (size_t i = 0; i < masks.size(); i++) {
+			if (masks[i] & bit)
+				return static_cast<source>(i + 1);
+		}
+
+		return source::none;
+	}
+
+	// Bits last written by `src`.
+	uint64_t mask(source src) const {
+		return src == source::none ? 0 : masks[static_cast<size_t>(src) - 1];
+	}
+
+	std::array<uint64_t, 4> masks{};
+};
+
+} // namespace conflict
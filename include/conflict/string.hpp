@@ -5,6 +5,7 @@
 #include <conflict/info.hpp>
 #include <conflict/detail.hpp>
 #include <conflict/error.hpp>
+#include <conflict/fixed_vector.hpp>
 
 namespace conflict {
 
@@ -23,6 +24,14 @@ struct string_option {
 
 	void print_extra(detail::line_printer &) const { }
 
+	template <typename F>
+	void complete_arg(std::string_view, F &&) const { }
+
+	template <typename W>
+	void dump_value(W &w) const {
+		w.string(target);
+	}
+
 	void apply_default() const {}
 
 	status process_arg(std::string_view arg) const {
@@ -32,6 +41,9 @@ struct string_option {
 	}
 };
 
+// Collects every value given to the option into `target`, which is either
+// a std::vector, or a fixed_vector to avoid allocating.
+template <typename Container = std::vector<std::string_view>>
 struct strings_option {
 	static constexpr bool needs_arg = true;
 
@@ -39,21 +51,38 @@ struct strings_option {
 
 	std::string_view placeholder;
 
-	std::vector<std::string_view> &target;
+	Container &target;
 
-	void print_argument_placeholder(detail::line_printer &pr) {
+	void print_argument_placeholder(detail::line_printer &pr) const {
 		pr.print(" <", placeholder, ">");
 	}
 
 	void print_extra(detail::line_printer &) const { }
 
+	template <typename F>
+	void complete_arg(std::string_view, F &&) const { }
+
+	template <typename W>
+	void dump_value(W &w) const {
+		w.begin_list();
+
+		for (auto &value : target)
+			w.string(value);
+
+		w.end_list();
+	}
+
 	void apply_default() const {}
 
 	status process_arg(std::string_view arg) const {
-		target.push_back(arg);
+		if (!detail::append(target, arg))
+			return status{error::too_many_values, arg, info.long_opt};
 
 		return status{};
 	}
 };
 
+template <typename Container>
+strings_option(option_info, std::string_view, Container &) -> strings_option<Container>;
+
 } // namespace conflict
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include <conflict/info.hpp>
+#include <conflict/error.hpp>
+#include <conflict/detail.hpp>
+#include <conflict/provenance.hpp>
+
+namespace conflict {
+
+namespace detail {
+	struct ignore_completion {
+		void operator()(std::string_view, std::string_view) const { }
+	};
+
+	template <typename T, typename = void>
+	struct has_common_members : std::false_type { };
+
+	template <typename T>
+	struct has_common_members<T, std::void_t<
+		decltype(std::declval<option_info &>() = std::declval<const T &>().info),
+		decltype(std::declval<const T &>().target),
+		decltype(bool{T::needs_arg}),
+		decltype(std::declval<const T &>().print_argument_placeholder(std::declval<line_printer &>())),
+		decltype(std::declval<const T &>().print_extra(std::declval<line_printer &>())),
+		decltype(std::declval<const T &>().complete_arg(std::string_view{}, ignore_completion{})),
+		decltype(std::declval<const T &>().apply_default())
+	>> : std::true_type { };
+
+	template <typename T, typename = void>
+	struct has_set : std::false_type { };
+
+	template <typename T>
+	struct has_set<T, std::void_t<decltype(std::declval<const T &>().set())>> : std::true_type { };
+
+	template <typename T, typename = void>
+	struct has_process_arg : std::false_type { };
+
+	template <typename T>
+	struct has_process_arg<T, std::void_t<decltype(std::declval<const T &>().process_arg(std::string_view{}))>>
+	: std::is_convertible<decltype(std::declval<const T &>().process_arg(std::string_view{})), status> { };
+
+	template <typename T, typename = void>
+	struct set_takes_source : std::false_type { };
+
+	template <typename T>
+	struct set_takes_source<T, std::void_t<decltype(std::declval<const T &>().set(source::argv))>>
+	: std::true_type { };
+
+	template <typename T, typename = void>
+	struct process_arg_takes_source : std::false_type { };
+
+	template <typename T>
+	struct process_arg_takes_source<T, std::void_t<decltype(std::declval<const T &>().process_arg(
+		std::string_view{}, source::argv))>> : std::true_type { };
+
+	// Pass the source along only to options that accept it.
+	template <typename T>
+	void set(const T &opt, source src) {
+		if constexpr (set_takes_source<T>::value)
+			opt.set(src);
+		else
+			opt.set();
+	}
+
+	template <typename T>
+	status process_arg(const T &opt, std::string_view arg, source src) {
+		if constexpr (process_arg_takes_source<T>::value)
+			return opt.process_arg(arg, src);
+		else
+			return opt.process_arg(arg);
+	}
+
+	template <typename T, bool = has_common_members<T>::value>
+	struct is_option_impl : std::false_type { };
+
+	template <typename T>
+	struct is_option_impl<T, true>
+	: std::bool_constant<T::needs_arg ? has_process_arg<T>::value : has_set<T>::value> { };
+} // namespace detail
+
+// Whether T can be used as an option in a parser. An option type provides:
+//  - `option_info info`, the names and description of the option,
+//  - `target`, a reference to the value, which is value-initialized by
+//    parser::apply_defaults,
+//  - `static constexpr bool needs_arg`, whether the option takes an argument,
+//  - `void print_argument_placeholder(detail::line_printer &) const` and
+//    `void print_extra(detail::line_printer &) const`, used for help output,
+//  - `template <typename F> void complete_arg(std::string_view word, F &&fn) const`,
+//    calling `fn(head, value)` for each completion of `word`,
+//  - `void apply_default() const`, setting the default value,
+//  - `void set() const` if the option takes no argument, or
+//    `status process_arg(std::string_view) const` if it does. Either may
+//    take an extra `conflict::source` argument, saying where the option
+//    came from.
+// Optionally, `template <typename W> void dump_value(W &w) const` writes the
+// current value for conflict::dump, and `template <typename H> void
+// hash_help(H &h) const` adds whatever print_argument_placeholder and
+// print_extra print beyond `info` to the key of a conflict::help_cache.
+// Option types are dispatched on statically, like the built-in ones.
+template <typename T>
+struct is_option : detail::is_option_impl<T> { };
+
+template <typename T>
+inline constexpr bool is_option_v = is_option<T>::value;
+
+} // namespace conflict
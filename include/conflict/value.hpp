@@ -0,0 +1,75 @@
+#pragma once
+
+#include <string_view>
+#include <type_traits>
+#include <charconv>
+#include <conflict/info.hpp>
+#include <conflict/detail.hpp>
+#include <conflict/error.hpp>
+
+namespace conflict {
+
+// Customization point for parsing option values of type T. Specializations
+// provide `static bool parse(std::string_view str, T &value)`, which returns
+// whether `str` was a valid value.
+template <typename T, typename = void>
+struct value_parser;
+
+template <>
+struct value_parser<std::string_view> {
+	static bool parse(std::string_view str, std::string_view &value) {
+		value = str;
+		return true;
+	}
+};
+
+template <typename T>
+struct value_parser<T, std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<T, bool>>> {
+	static bool parse(std::string_view str, T &value) {
+		auto end = str.data() + str.size();
+		auto [ptr, ec] = std::from_chars(str.data(), end, value);
+
+		return ec == std::errc{} && ptr == end;
+	}
+};
+
+template <typename T>
+struct value_option {
+	static constexpr bool needs_arg = true;
+
+	option_info info;
+
+	std::string_view placeholder;
+
+	T &target;
+
+	void print_argument_placeholder(detail::line_printer &pr) const {
+		pr.print(" <", placeholder, ">");
+	}
+
+	void print_extra(detail::line_printer &) const { }
+
+	template <typename F>
+	void complete_arg(std::string_view, F &&) const { }
+
+	template <typename W>
+	void dump_value(W &w) const {
+		w.value(target);
+	}
+
+	void apply_default() const {}
+
+	status process_arg(std::string_view arg) const {
+		T value{};
+		if (!value_parser<T>::parse(arg, value))
+			return status{error::invalid_argument, arg, info.long_opt};
+
+		target = value;
+		return status{};
+	}
+};
+
+template <typename T>
+value_option(option_info, std::string_view, T &) -> value_option<T>;
+
+} // namespace conflict
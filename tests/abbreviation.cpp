@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+
+#include <conflict/option.hpp>
+#include <conflict/string.hpp>
+#include <conflict/parser.hpp>
+
+namespace {
+
+uint64_t flags;
+std::string_view output;
+
+auto make_parser() {
+	auto parser = conflict::parser{
+		conflict::option{{'v', "verbose", "Be verbose"}, flags, 1},
+		conflict::option{{"version", "Show version"}, flags, 2},
+		conflict::option{{"ver", "Exact prefix of other options"}, flags, 4},
+		conflict::string_option{{'o', "output", "Output file"}, "filename", output}
+	};
+
+	parser.allow_abbreviations = true;
+	return parser;
+}
+
+const auto parser = make_parser();
+
+} // namespace anonymous
+
+TEST(Abbreviation, Unique) {
+	parser.apply_defaults();
+	auto st = parser.parse({"--verb", "--versi"});
+
+	ASSERT_TRUE(st);
+	ASSERT_EQ(st.err, conflict::error::ok);
+	ASSERT_EQ(flags, 1 | 2);
+}
+
+TEST(Abbreviation, ExactWins) {
+	parser.apply_defaults();
+	auto st = parser.parse({"--ver"});
+
+	ASSERT_TRUE(st);
+	ASSERT_EQ(st.err, conflict::error::ok);
+	ASSERT_EQ(flags, 4);
+}
+
+TEST(Abbreviation, WithValue) {
+	parser.apply_defaults();
+	auto st = parser.parse({"--out=foo"});
+
+	ASSERT_TRUE(st);
+	ASSERT_EQ(st.err, conflict::error::ok);
+	ASSERT_EQ(output, "foo");
+}
+
+TEST(Abbreviation, Ambiguous) {
+	parser.apply_defaults();
+	auto st = parser.parse({"--ve"});
+
+	ASSERT_FALSE(st);
+	ASSERT_EQ(st.err, conflict::error::ambiguous_option);
+	ASSERT_EQ(st.what1, "--ve");
+	ASSERT_EQ(st.n_candidates, 3);
+	ASSERT_EQ(st.candidates[0], "ver");
+	ASSERT_EQ(st.candidates[1], "verbose");
+	ASSERT_EQ(st.candidates[2], "version");
+}
+
+TEST(Abbreviation, Invalid) {
+	parser.apply_defaults();
+	auto st = parser.parse({"--x"});
+
+	ASSERT_FALSE(st);
+	ASSERT_EQ(st.err, conflict::error::invalid_option);
+	ASSERT_EQ(st.what1, "--x");
+}
+
+TEST(Abbreviation, DisabledByDefault) {
+	const auto exact_parser = conflict::parser{
+		conflict::option{{'v', "verbose", "Be verbose"}, flags, 1}
+	};
+
+	auto st = exact_parser.parse({"--verb"});
+
+	ASSERT_FALSE(st);
+	ASSERT_EQ(st.err, conflict::error::invalid_option);
+	ASSERT_EQ(st.what1, "--verb");
+}
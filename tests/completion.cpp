@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+
+#include <conflict/choice.hpp>
+#include <conflict/option.hpp>
+#include <conflict/string.hpp>
+#include <conflict/parser.hpp>
+#include <conflict/completion.hpp>
+
+namespace {
+
+uint64_t flags;
+uint64_t features;
+uint64_t language;
+std::string_view output;
+std::string_view secret;
+
+const auto parser = conflict::parser{
+	conflict::option{{'v', "verbose", "Be verbose"}, flags, 1},
+	conflict::option{{"version", "Show version"}, flags, 2},
+	conflict::string_option{{'o', "output", "Output file"}, "filename", output},
+	conflict::string_option{conflict::option_info{'s', "secret", "Internal"}.hide(), "value", secret},
+	conflict::choice{{'f', "features", "Features"}, conflict::choice_mode::combine, features,
+		conflict::flag{{"feat1"}, 1},
+		conflict::flag{{"feat2"}, 2},
+		conflict::flag{{"exp1"}, 4}
+	},
+	conflict::choice{{'l', "language", "Language"}, conflict::choice_mode::replace, language,
+		conflict::flag{{"english"}, 1},
+		conflict::flag{{"polish"}, 2}
+	}
+};
+
+std::string complete(std::vector<std::string_view> args) {
+	testing::internal::CaptureStdout();
+	bool handled = conflict::complete(parser, args);
+	auto out = testing::internal::GetCapturedStdout();
+
+	return handled ? out : "(not handled)";
+}
+
+} // namespace anonymous
+
+TEST(Completion, NotQuery) {
+	ASSERT_EQ(complete({"--verbose"}), "(not handled)");
+	ASSERT_EQ(complete({}), "(not handled)");
+}
+
+TEST(Completion, LongPrefix) {
+	ASSERT_EQ(complete({"__complete", "--ver"}), "--verbose\n--version\n");
+	ASSERT_EQ(complete({"__complete", "-o", "x", "--l"}), "--language\n");
+	ASSERT_EQ(complete({"__complete", "--x"}), "");
+}
+
+TEST(Completion, AllOptions) {
+	ASSERT_EQ(complete({"__complete", "-"}),
+		"-v\n-o\n-f\n-l\n--features\n--language\n--output\n--verbose\n--version\n");
+}
+
+TEST(Completion, ChoiceValues) {
+	ASSERT_EQ(complete({"__complete", "-l", ""}), "english\npolish\n");
+	ASSERT_EQ(complete({"__complete", "--language", "p"}), "polish\n");
+	ASSERT_EQ(complete({"__complete", "--language=e"}), "--language=english\n");
+}
+
+TEST(Completion, CombineValues) {
+	ASSERT_EQ(complete({"__complete", "-f", "feat1,-f"}), "feat1,-feat1\nfeat1,-feat2\n");
+	ASSERT_EQ(complete({"__complete", "--features=e"}), "--features=exp1\n");
+}
+
+TEST(Completion, StringValue) {
+	ASSERT_EQ(complete({"__complete", "-o", "--ver"}), "");
+	ASSERT_EQ(complete({"__complete", "-v", "--ver"}), "--verbose\n--version\n");
+}
+
+TEST(Completion, Hidden) {
+	ASSERT_EQ(complete({"__complete", "--s"}), "");
+
+	for (auto sh : {conflict::shell::bash, conflict::shell::zsh, conflict::shell::fish}) {
+		testing::internal::CaptureStdout();
+		conflict::print_completion(parser, sh, "my-prog");
+		auto script = testing::internal::GetCapturedStdout();
+
+		ASSERT_EQ(script.find("secret"), std::string::npos) << script;
+	}
+}
+
+TEST(Completion, Scripts) {
+	testing::internal::CaptureStdout();
+	conflict::print_completion(parser, conflict::shell::bash, "my-prog");
+	auto bash = testing::internal::GetCapturedStdout();
+
+	ASSERT_NE(bash.find("-l|--language)\n\t\t\tCOMPREPLY=($(compgen -W 'english polish'"), std::string::npos);
+	ASSERT_NE(bash.find("-o|--output)\n\t\t\tCOMPREPLY=($(compgen -f"), std::string::npos);
+	ASSERT_NE(bash.find("complete -F _my_prog my-prog\n"), std::string::npos);
+
+	testing::internal::CaptureStdout();
+	conflict::print_completion(parser, conflict::shell::zsh, "my-prog");
+	auto zsh = testing::internal::GetCapturedStdout();
+
+	ASSERT_NE(zsh.find("#compdef my-prog\n"), std::string::npos);
+	ASSERT_NE(zsh.find("'*'{-o+,--output=}'[Output file]:filename:_files' \\\n"), std::string::npos);
+	ASSERT_NE(zsh.find("'*'--version'[Show version]' \\\n"), std::string::npos);
+	ASSERT_NE(zsh.find(":language:(english polish)'"), std::string::npos);
+
+	testing::internal::CaptureStdout();
+	conflict::print_completion(parser, conflict::shell::fish, "my-prog");
+	auto fish = testing::internal::GetCapturedStdout();
+
+	ASSERT_NE(fish.find("complete -c my-prog -s f -l features -x -a 'feat1 feat2 exp1' -d 'Features'\n"), std::string::npos);
+	ASSERT_NE(fish.find("complete -c my-prog -s v -l verbose -d 'Be verbose'\n"), std::string::npos);
+}
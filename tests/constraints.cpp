@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+
+#include <conflict/option.hpp>
+#include <conflict/string.hpp>
+#include <conflict/parser.hpp>
+
+namespace {
+
+uint64_t flags;
+std::string_view output;
+std::string_view format;
+
+constexpr auto parser = conflict::parser{
+	conflict::option{{'n', "dry-run", "Don't write anything"}, flags, 1},
+	conflict::string_option{{'o', "output", "Output file"}, "file", output},
+	conflict::option{{'q', "quiet", "Be quiet"}, flags, 2},
+	conflict::option{{'v', "verbose", "Be verbose"}, flags, 4},
+	conflict::option{{'d', "debug", "Debug output"}, flags, 8},
+	conflict::string_option{{'f', "format", "Output format"}, "fmt", format}
+}.constrain({
+	conflict::required("output", "dry-run"),
+	conflict::conflicts("quiet", "verbose"),
+	conflict::conflicts("quiet", "debug"),
+	conflict::depends("format", "output")
+});
+
+using option_set = std::decay_t<decltype(parser)>::option_set;
+
+template <typename P>
+conflict::status parse_checked(const P &p, const std::vector<std::string_view> &args) {
+	typename P::option_set seen{};
+
+	if (auto st = p.parse(args, nullptr, conflict::source::argv, &seen); !st)
+		return st;
+
+	return p.check_constraints(seen);
+}
+
+} // namespace anonymous
+
+TEST(Constraints, Satisfied) {
+	parser.apply_defaults();
+	auto st = parse_checked(parser, {"-o", "out", "-v", "-f", "json"});
+
+	ASSERT_TRUE(st);
+	ASSERT_EQ(st.err, conflict::error::ok);
+}
+
+TEST(Constraints, MissingRequired) {
+	parser.apply_defaults();
+	auto st = parse_checked(parser, {"-v"});
+
+	ASSERT_FALSE(st);
+	ASSERT_EQ(st.err, conflict::error::missing_option);
+	ASSERT_EQ(st.what1, "output");
+}
+
+TEST(Constraints, RequiredUnless) {
+	parser.apply_defaults();
+	auto st = parse_checked(parser, {"--dry-run"});
+
+	ASSERT_TRUE(st);
+	ASSERT_EQ(st.err, conflict::error::ok);
+}
+
+TEST(Constraints, Conflict) {
+	parser.apply_defaults();
+	auto st = parse_checked(parser, {"-o", "out", "-vq"});
+
+	ASSERT_FALSE(st);
+	ASSERT_EQ(st.err, conflict::error::conflicting_options);
+	ASSERT_EQ(st.what1, "quiet");
+	ASSERT_EQ(st.what2, "verbose");
+}
+
+TEST(Constraints, SeveralConflicts) {
+	parser.apply_defaults();
+	auto st = parse_checked(parser, {"-o", "out", "-qd"});
+
+	ASSERT_FALSE(st);
+	ASSERT_EQ(st.err, conflict::error::conflicting_options);
+	ASSERT_EQ(st.what1, "quiet");
+	ASSERT_EQ(st.what2, "debug");
+}
+
+TEST(Constraints, SeveralDependencies) {
+	auto p = conflict::parser{
+		conflict::option{{'a', "alpha"}, flags, 1},
+		conflict::option{{'b', "beta"}, flags, 2},
+		conflict::option{{'g', "gamma"}, flags, 4}
+	}.constrain({
+		conflict::depends("alpha", "beta"),
+		conflict::depends("alpha", "gamma")
+	});
+
+	auto st = parse_checked(p, {"-ab"});
+
+	ASSERT_FALSE(st);
+	ASSERT_EQ(st.err, conflict::error::missing_dependency);
+	ASSERT_EQ(st.what1, "alpha");
+	ASSERT_EQ(st.what2, "gamma");
+
+	ASSERT_TRUE(parse_checked(p, {"-abg"}));
+}
+
+TEST(Constraints, MissingDependency) {
+	parser.apply_defaults();
+	auto st = parse_checked(parser, {"-n", "-f", "json"});
+
+	ASSERT_FALSE(st);
+	ASSERT_EQ(st.err, conflict::error::missing_dependency);
+	ASSERT_EQ(st.what1, "format");
+	ASSERT_EQ(st.what2, "output");
+}
+
+TEST(Constraints, NotCheckedByParse) {
+	parser.apply_defaults();
+
+	// Lets e.g. --help be handled without giving the required options.
+	ASSERT_TRUE(parser.parse({"-v"}));
+	ASSERT_TRUE(parser.parse({"-vq"}));
+}
+
+TEST(Constraints, AcrossSources) {
+	option_set seen{};
+
+	parser.apply_defaults();
+	ASSERT_TRUE(parser.parse({"-o", "out"}, nullptr, conflict::source::env, &seen));
+	ASSERT_TRUE(parser.parse({"-f", "json"}, nullptr, conflict::source::argv, &seen));
+	ASSERT_TRUE(parser.check_constraints(seen));
+
+	ASSERT_TRUE(parser.parse({"-q"}, nullptr, conflict::source::argv, &seen));
+	ASSERT_TRUE(parser.parse({"-v"}, nullptr, conflict::source::argv, &seen));
+
+	auto st = parser.check_constraints(seen);
+	ASSERT_EQ(st.err, conflict::error::conflicting_options);
+}
+
+TEST(ConstraintsDeathTest, UnknownOption) {
+	ASSERT_DEATH((conflict::parser{
+		conflict::option{{'a', "alpha"}, flags, 1}
+	}.constrain({conflict::depends("alpha", "beta")})), "unknown option");
+}
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+
+#include <conflict/option.hpp>
+#include <conflict/string.hpp>
+#include <conflict/parser.hpp>
+
+namespace {
+
+uint64_t verbosity;
+uint64_t flags;
+std::string_view output;
+
+const auto parser = conflict::parser{
+	conflict::counter_option{{'v', "verbose", "Increase verbosity"}, verbosity},
+	conflict::option{{'q', "quiet", "Be quiet"}, flags, 1},
+	conflict::string_option{{'o', "output", "Output file"}, "filename", output}
+};
+
+} // namespace anonymous
+
+TEST(Counter, None) {
+	parser.apply_defaults();
+	auto st = parser.parse({});
+
+	ASSERT_TRUE(st);
+	ASSERT_EQ(st.err, conflict::error::ok);
+	ASSERT_EQ(verbosity, 0);
+}
+
+TEST(Counter, Repeated) {
+	parser.apply_defaults();
+	auto st = parser.parse({"--verbose", "-v", "--verbose"});
+
+	ASSERT_TRUE(st);
+	ASSERT_EQ(st.err, conflict::error::ok);
+	ASSERT_EQ(verbosity, 3);
+}
+
+TEST(Counter, Bundled) {
+	parser.apply_defaults();
+	auto st = parser.parse({"-vvqv"});
+
+	ASSERT_TRUE(st);
+	ASSERT_EQ(st.err, conflict::error::ok);
+	ASSERT_EQ(verbosity, 3);
+	ASSERT_EQ(flags, 1);
+}
+
+TEST(Counter, BundledArgumentAttached) {
+	parser.apply_defaults();
+	auto st = parser.parse({"-vofoo"});
+
+	ASSERT_TRUE(st);
+	ASSERT_EQ(st.err, conflict::error::ok);
+	ASSERT_EQ(verbosity, 1);
+	ASSERT_EQ(output, "foo");
+}
+
+TEST(Counter, BundledArgumentNext) {
+	parser.apply_defaults();
+	auto st = parser.parse({"-vo", "foo"});
+
+	ASSERT_TRUE(st);
+	ASSERT_EQ(st.err, conflict::error::ok);
+	ASSERT_EQ(verbosity, 1);
+	ASSERT_EQ(output, "foo");
+}
+
+TEST(Counter, BundledInvalid) {
+	parser.apply_defaults();
+	auto st = parser.parse({"-vxv"});
+
+	ASSERT_FALSE(st);
+	ASSERT_EQ(st.err, conflict::error::invalid_option);
+	ASSERT_EQ(st.what1, "-vxv");
+}
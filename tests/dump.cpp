@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include <conflict/choice.hpp>
+#include <conflict/option.hpp>
+#include <conflict/string.hpp>
+#include <conflict/value.hpp>
+#include <conflict/list.hpp>
+#include <conflict/parser.hpp>
+#include <conflict/dump.hpp>
+
+namespace {
+
+uint64_t flags;
+uint64_t verbosity;
+uint64_t features;
+uint64_t language;
+std::string_view output;
+std::vector<std::string_view> includes;
+std::vector<int> levels;
+double ratio;
+
+const auto parser = conflict::parser{
+	conflict::option{{'h', "help", "Show help"}, flags, 1},
+	conflict::option{{'q', {}, "Be quiet"}, flags, 2},
+	conflict::counter_option{{'v', "verbose", "Verbosity"}, verbosity},
+	conflict::string_option{{'o', "output", "Output"}, "file", output},
+	conflict::strings_option{{'I', "include", "Include"}, "dir", includes},
+	conflict::list_option{{'l', "level", "Levels"}, "n", levels},
+	conflict::value_option{{'r', "ratio", "Ratio"}, "x", ratio},
+	conflict::choice{{'f', "features", "Features"}, conflict::choice_mode::combine, features,
+		conflict::flag{{"all"}, 1 | 2, conflict::flag::is_default},
+		conflict::flag{{"feat1"}, 1},
+		conflict::flag{{"feat2"}, 2}
+	},
+	conflict::choice{{"language", "Language"}, conflict::choice_mode::replace, language,
+		conflict::flag{{"english"}, 1},
+		conflict::flag{{"polish"}, 2}
+	}
+};
+
+} // namespace anonymous
+
+TEST(Dump, Json) {
+	std::vector<std::string_view> pos;
+
+	parser.apply_defaults();
+	auto st = parser.parse({"-vvq", "-o", "a \"b\"", "-I", "x", "-Iy",
+			"-l", "1", "-l", "-2", "-r", "0.5", "-f", "-feat2", "--language=polish", "file"}, pos);
+	ASSERT_TRUE(st);
+
+	char buf[512];
+	auto n = conflict::dump(parser, buf, sizeof(buf), conflict::dump_format::json, pos);
+
+	ASSERT_EQ(std::string_view(buf, n),
+		"{\"help\":false,\"q\":true,\"verbose\":2,\"output\":\"a \\\"b\\\"\","
+		"\"include\":[\"x\",\"y\"],\"level\":[1,-2],\"ratio\":0.5,"
+		"\"features\":[\"feat1\"],\"language\":\"polish\",\"positional\":[\"file\"]}\n");
+}
+
+TEST(Dump, KeyValue) {
+	parser.apply_defaults();
+	auto st = parser.parse({"-h", "-I", "x", "-I", "y"});
+	ASSERT_TRUE(st);
+
+	char buf[512];
+	auto n = conflict::dump(parser, buf, sizeof(buf), conflict::dump_format::key_value);
+
+	ASSERT_EQ(std::string_view(buf, n),
+		"help=true\nq=false\nverbose=0\noutput=\"\"\ninclude=x,y\nlevel=\nratio=0\n"
+		"features=all,feat1,feat2\nlanguage=\n");
+}
+
+TEST(Dump, KeyValueQuoting) {
+	parser.apply_defaults();
+	auto st = parser.parse({"-o", "a\nb=c", "-I", "x,y", "-I", "z", "-I", "say \"hi\""});
+	ASSERT_TRUE(st);
+
+	char buf[512];
+	auto n = conflict::dump(parser, buf, sizeof(buf), conflict::dump_format::key_value);
+	auto out = std::string_view(buf, n);
+
+	ASSERT_NE(out.find("output=\"a\\u000ab=c\"\n"), std::string_view::npos) << out;
+	ASSERT_NE(out.find("include=\"x,y\",z,\"say \\\"hi\\\"\"\n"), std::string_view::npos) << out;
+}
+
+TEST(Dump, NonFinite) {
+	parser.apply_defaults();
+	auto st = parser.parse({"-r", "nan"});
+	ASSERT_TRUE(st);
+
+	char buf[512];
+	auto n = conflict::dump(parser, buf, sizeof(buf), conflict::dump_format::json);
+	auto out = std::string_view(buf, n);
+
+	ASSERT_NE(out.find("\"ratio\":null,"), std::string_view::npos) << out;
+}
+
+TEST(Dump, Truncated) {
+	parser.apply_defaults();
+
+	char buf[8] = {};
+	auto n = conflict::dump(parser, buf, 4, conflict::dump_format::json);
+
+	ASSERT_GT(n, 4);
+	ASSERT_EQ(std::string_view(buf, 4), "{\"he");
+	ASSERT_EQ(buf[4], 0);
+}
@@ -0,0 +1,221 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include <conflict/option.hpp>
+#include <conflict/string.hpp>
+#include <conflict/value.hpp>
+#include <conflict/parser.hpp>
+#include <conflict/completion.hpp>
+#include <conflict/dump.hpp>
+
+namespace {
+
+uint64_t flags;
+std::string_view output;
+uint64_t plugin_flags;
+std::string_view plugin_mode;
+
+constexpr auto static_parser = conflict::parser{
+	conflict::option{{'v', "verbose", "Be verbose"}, flags, 1},
+	conflict::string_option{{'o', "output", "Output file"}, "file", output}
+};
+
+conflict::dynamic_parser make_plugins() {
+	conflict::dynamic_parser plugins;
+
+	EXPECT_TRUE(plugins.add(conflict::option{{'x', "extra", "Extra checks"}, plugin_flags, 1}));
+	EXPECT_TRUE(plugins.add(conflict::option{{"plugin-debug"}, plugin_flags, 2}));
+	EXPECT_TRUE(plugins.add(conflict::string_option{{'m', "mode", "Plugin mode"}, "mode", plugin_mode}));
+
+	return plugins;
+}
+
+} // namespace anonymous
+
+TEST(Dynamic, FallThrough) {
+	auto plugins = make_plugins();
+	auto p = static_parser;
+	ASSERT_TRUE(p.attach(plugins));
+
+	p.apply_defaults();
+	auto st = p.parse({"-v", "--extra", "--mode=fast", "--plugin-debug", "-o", "out"});
+
+	ASSERT_TRUE(st);
+	ASSERT_EQ(flags, 1);
+	ASSERT_EQ(plugin_flags, 1 | 2);
+	ASSERT_EQ(plugin_mode, "fast");
+	ASSERT_EQ(output, "out");
+}
+
+TEST(Dynamic, ShortBundles) {
+	auto plugins = make_plugins();
+	auto p = static_parser;
+	ASSERT_TRUE(p.attach(plugins));
+
+	p.apply_defaults();
+	auto st = p.parse({"-vxmslow"});
+
+	ASSERT_TRUE(st);
+	ASSERT_EQ(flags, 1);
+	ASSERT_EQ(plugin_flags, 1);
+	ASSERT_EQ(plugin_mode, "slow");
+}
+
+TEST(Dynamic, Errors) {
+	auto plugins = make_plugins();
+	auto p = static_parser;
+	ASSERT_TRUE(p.attach(plugins));
+
+	auto st = p.parse({"--unknown"});
+	ASSERT_EQ(st.err, conflict::error::invalid_option);
+
+	st = p.parse({"--mode"});
+	ASSERT_EQ(st.err, conflict::error::missing_argument);
+
+	st = p.parse({"--extra=1"});
+	ASSERT_EQ(st.err, conflict::error::invalid_argument);
+}
+
+TEST(Dynamic, DuplicateNames) {
+	auto plugins = make_plugins();
+
+	ASSERT_FALSE(plugins.add(conflict::option{{"extra"}, plugin_flags, 4}));
+	ASSERT_FALSE(plugins.add(conflict::option{{'x', "other"}, plugin_flags, 4}));
+	ASSERT_EQ(plugins.size(), 3);
+}
+
+TEST(Dynamic, StaticNamesReserved) {
+	auto plugins = make_plugins();
+	auto p = static_parser;
+	ASSERT_TRUE(p.attach(plugins));
+
+	ASSERT_FALSE(plugins.add(conflict::option{{'v', "vv"}, plugin_flags, 4}));
+	ASSERT_FALSE(plugins.add(conflict::option{{"output"}, plugin_flags, 4}));
+	ASSERT_TRUE(plugins.add(conflict::option{{'w', "outputs"}, plugin_flags, 4}));
+	ASSERT_EQ(plugins.size(), 4);
+
+	// Reserved names survive the table growing.
+	std::vector<std::string> names;
+	uint64_t many;
+
+	for (size_t i = 0; i < 100; i++)
+		names.push_back("plugin-" + std::to_string(i));
+	for (auto &name : names)
+		ASSERT_TRUE(plugins.add(conflict::option{{name}, many, 1}));
+
+	ASSERT_FALSE(plugins.add(conflict::option{{"verbose"}, plugin_flags, 4}));
+	ASSERT_NE(plugins.find("plugin-42"), nullptr);
+	ASSERT_EQ(plugins.find("output"), nullptr);
+
+	// Options registered before attaching can't be rejected, but are reported.
+	conflict::dynamic_parser late;
+	ASSERT_TRUE(late.add(conflict::option{{"verbose"}, plugin_flags, 4}));
+
+	auto q = static_parser;
+	ASSERT_FALSE(q.attach(late));
+}
+
+TEST(Dynamic, ManyOptions) {
+	std::vector<std::string> names;
+	std::vector<uint64_t> targets(200);
+
+	for (size_t i = 0; i < targets.size(); i++)
+		names.push_back("option-" + std::to_string(i));
+
+	conflict::dynamic_parser plugins;
+	for (size_t i = 0; i < targets.size(); i++)
+		ASSERT_TRUE(plugins.add(conflict::option{{names[i]}, targets[i], 1}));
+
+	auto p = conflict::parser{};
+	ASSERT_TRUE(p.attach(plugins));
+
+	p.apply_defaults();
+	auto st = p.parse({"--option-0", "--option-137", "--option-199"});
+
+	ASSERT_TRUE(st);
+	for (size_t i = 0; i < targets.size(); i++)
+		ASSERT_EQ(targets[i], i == 0 || i == 137 || i == 199) << names[i];
+}
+
+TEST(Dynamic, Abbreviations) {
+	conflict::dynamic_parser plugins;
+	ASSERT_TRUE(plugins.add(conflict::option{{"verb"}, plugin_flags, 4}));
+
+	auto p = static_parser;
+	ASSERT_TRUE(p.attach(plugins));
+	p.allow_abbreviations = true;
+
+	p.apply_defaults();
+	ASSERT_TRUE(p.parse({"--verb", "--verbo"}));
+	ASSERT_EQ(plugin_flags, 4);
+	ASSERT_EQ(flags, 1);
+}
+
+TEST(Dynamic, Help) {
+	conflict::dynamic_parser plugins;
+	ASSERT_TRUE(plugins.add(conflict::option{conflict::option_info{'x', "extra", "Extra checks"}.in_group("Plugins"),
+		plugin_flags, 1}));
+	ASSERT_TRUE(plugins.add(conflict::option{conflict::option_info{"internal"}.hide(), plugin_flags, 2}));
+
+	auto p = static_parser;
+	ASSERT_TRUE(p.attach(plugins));
+
+	testing::internal::CaptureStdout();
+	p.print_help();
+	ASSERT_TRUE(p.print_help("Plugins"));
+	auto out = testing::internal::GetCapturedStdout();
+
+	ASSERT_EQ(out,
+		"    -v/--verbose                Be verbose\n"
+		"    -o/--output <file>          Output file\n"
+		"\n"
+		"Plugins:\n"
+		"    -x/--extra                  Extra checks\n"
+		"Plugins:\n"
+		"    -x/--extra                  Extra checks\n");
+}
+
+TEST(Dynamic, Completion) {
+	auto plugins = make_plugins();
+	auto p = static_parser;
+	ASSERT_TRUE(p.attach(plugins));
+
+	auto complete = [&] (std::vector<std::string_view> args) {
+		testing::internal::CaptureStdout();
+		EXPECT_TRUE(conflict::complete(p, args));
+		return testing::internal::GetCapturedStdout();
+	};
+
+	ASSERT_EQ(complete({"__complete", "--"}),
+		"--extra\n--mode\n--output\n--plugin-debug\n--verbose\n");
+	ASSERT_EQ(complete({"__complete", "--m"}), "--mode\n");
+	ASSERT_EQ(complete({"__complete", "-"}), "-v\n-o\n-x\n-m\n"
+		"--extra\n--mode\n--output\n--plugin-debug\n--verbose\n");
+
+	testing::internal::CaptureStdout();
+	conflict::print_completion(p, conflict::shell::fish, "prog");
+	auto out = testing::internal::GetCapturedStdout();
+
+	ASSERT_NE(out.find("complete -c prog -s x -l extra"), std::string::npos);
+	ASSERT_NE(out.find("complete -c prog -s m -l mode -r -F"), std::string::npos);
+}
+
+TEST(Dynamic, Dump) {
+	auto plugins = make_plugins();
+	auto p = static_parser;
+	ASSERT_TRUE(p.attach(plugins));
+
+	p.apply_defaults();
+	ASSERT_TRUE(p.parse({"-v", "--mode=fast", "-o", "out"}));
+
+	char buf[256];
+	auto n = conflict::dump(p, buf, sizeof(buf), conflict::dump_format::key_value);
+
+	ASSERT_EQ(std::string_view(buf, n),
+		"verbose=true\n"
+		"output=out\n"
+		"extra=false\n"
+		"plugin-debug=false\n"
+		"mode=fast\n");
+}
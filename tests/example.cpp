@@ -3,15 +3,18 @@
 uint64_t flags;
 uint64_t feature_flags;
 uint64_t language;
+uint64_t debug_level;
 std::string_view output;
 std::vector<std::string_view> files;
 
-const auto parser = conflict::parser{
+constexpr auto parser = conflict::parser{
 	// You can define simple command line option that only set a value ...
 	conflict::option{{'h', "help", "Show help"}, flags, (1 << 0)},
 	conflict::option{{'V', "version", "Show version"}, flags, (1 << 1)},
 	// Options may not have a short variant.
 	conflict::option{{"verbose", "Be verbose"}, flags, (1 << 2)},
+	// ... and options which count how many times they were given (e.g. -ddd) ...
+	conflict::counter_option{{'d', "debug", "Increase debug level"}, debug_level},
 	// ... and options which consume a string ...
 	conflict::string_option{{'o', "output", "Output file name"}, "filename", output},
 	// ... and options which consume a combination of flags, and which allow for complex selections like all,-feat2,exp1 ...
@@ -34,6 +37,10 @@ const auto parser = conflict::parser{
 };
 
 int main(int argc, char **argv) {
+	// Answer shell completion queries before doing anything else.
+	if (conflict::complete(parser, argc - 1, argv + 1))
+		return 0;
+
 	// Reset all flags to their default values.
 	parser.apply_defaults();
 
@@ -57,6 +64,8 @@ int main(int argc, char **argv) {
 	if (flags & (1 << 2))
 		std::cout << "Verbosity increased\n";
 
+	std::cout << "Debug level: " << debug_level << "\n";
+
 	std::cout << "Output: \"" << output << "\"\n";
 
 	std::cout << "Features: ";
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+
+#include <conflict/choice.hpp>
+#include <conflict/option.hpp>
+#include <conflict/string.hpp>
+#include <conflict/parser.hpp>
+
+namespace {
+
+uint64_t flags;
+uint64_t language;
+std::vector<std::string_view> includes;
+
+const auto parser = conflict::parser{
+	conflict::option{{'h', "help", "Show help"}, flags, 1},
+	conflict::option{{"verbose"}, flags, 2},
+	conflict::strings_option{{'I', "include", "Include directory"}, "dir", includes},
+	conflict::choice{{'l', "language", "Language"}, conflict::choice_mode::replace, language,
+		conflict::flag{{"english", "English"}, 1},
+		conflict::flag{{"polish"}, 2}
+	}
+};
+
+} // namespace anonymous
+
+TEST(Help, Output) {
+	testing::internal::CaptureStdout();
+	parser.print_help();
+	auto out = testing::internal::GetCapturedStdout();
+
+	ASSERT_EQ(out,
+		"    -h/--help                   Show help\n"
+		"    --verbose\n"
+		"    -I/--include <dir>          Include directory\n"
+		"    -l/--language {english|polish}\n"
+		"                                Language\n"
+		"        english                     English\n");
+}
+
+namespace {
+
+uint64_t grouped_flags;
+
+const auto grouped_parser = conflict::parser{
+	conflict::option{{'h', "help", "Show help"}, grouped_flags, 1},
+	conflict::option{conflict::option_info{"trace", "Trace execution"}.in_group("Debugging"), grouped_flags, 2},
+	conflict::option{conflict::option_info{'q', "quiet", "Be quiet"}.in_group("Output"), grouped_flags, 4},
+	conflict::option{conflict::option_info{"dump-ir", "Dump the IR"}.in_group("Debugging"), grouped_flags, 8},
+	conflict::option{conflict::option_info{"internal-check"}.hide(), grouped_flags, 16},
+	conflict::option{conflict::option_info{"fuzz"}.in_group("Testing").hide(), grouped_flags, 32}
+};
+
+} // namespace anonymous
+
+TEST(Help, Groups) {
+	testing::internal::CaptureStdout();
+	grouped_parser.print_help();
+	auto out = testing::internal::GetCapturedStdout();
+
+	ASSERT_EQ(out,
+		"    -h/--help                   Show help\n"
+		"\n"
+		"Debugging:\n"
+		"    --trace                     Trace execution\n"
+		"    --dump-ir                   Dump the IR\n"
+		"\n"
+		"Output:\n"
+		"    -q/--quiet                  Be quiet\n");
+}
+
+TEST(Help, SingleGroup) {
+	testing::internal::CaptureStdout();
+	ASSERT_TRUE(grouped_parser.print_help("Debugging"));
+	auto out = testing::internal::GetCapturedStdout();
+
+	ASSERT_EQ(out,
+		"Debugging:\n"
+		"    --trace                     Trace execution\n"
+		"    --dump-ir                   Dump the IR\n");
+}
+
+TEST(Help, MissingGroup) {
+	testing::internal::CaptureStdout();
+	ASSERT_FALSE(grouped_parser.print_help("Nonexistent"));
+	ASSERT_FALSE(grouped_parser.print_help("Testing"));
+	auto out = testing::internal::GetCapturedStdout();
+
+	ASSERT_EQ(out, "");
+}
+
+TEST(Help, HiddenOptionsParse) {
+	grouped_parser.apply_defaults();
+	auto st = grouped_parser.parse({"--internal-check", "--fuzz"});
+
+	ASSERT_TRUE(st);
+	ASSERT_EQ(grouped_flags, 16 | 32);
+}
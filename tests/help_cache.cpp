@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <cstdlib>
+
+#include <conflict/choice.hpp>
+#include <conflict/option.hpp>
+#include <conflict/string.hpp>
+#include <conflict/parser.hpp>
+#include <conflict/help_cache.hpp>
+
+namespace {
+
+uint64_t flags;
+std::string_view output;
+
+const auto parser = conflict::parser{
+	conflict::option{{'h', "help", "Show help"}, flags, 1},
+	conflict::string_option{{'o', "output", "Output file"}, "file", output},
+	conflict::option{conflict::option_info{"trace", "Trace execution"}.in_group("Debugging"), flags, 2}
+};
+
+template <typename P>
+std::string render(const P &p) {
+	testing::internal::CaptureStdout();
+	p.print_help();
+	return testing::internal::GetCapturedStdout();
+}
+
+template <typename P>
+std::string render(const P &p, conflict::help_cache &cache) {
+	testing::internal::CaptureStdout();
+	conflict::print_help(p, cache);
+	return testing::internal::GetCapturedStdout();
+}
+
+} // namespace anonymous
+
+TEST(HelpCache, SameOutput) {
+	auto expected = render(parser);
+
+	conflict::help_cache cache;
+
+	ASSERT_EQ(render(parser, cache), expected);
+	ASSERT_TRUE(cache.valid);
+	ASSERT_EQ(cache.text, expected);
+}
+
+TEST(HelpCache, ServedFromCache) {
+	conflict::help_cache cache;
+
+	render(parser, cache);
+	cache.text = "cached\n";
+
+	ASSERT_EQ(render(parser, cache), "cached\n");
+}
+
+TEST(HelpCache, KeyedByOptions) {
+	conflict::help_cache cache;
+
+	render(parser, cache);
+	auto key = cache.key;
+	cache.text = "stale\n";
+
+	auto other = conflict::parser{
+		conflict::option{{'h', "help", "Show this help"}, flags, 1},
+		conflict::string_option{{'o', "output", "Output file"}, "file", output},
+		conflict::option{conflict::option_info{"trace", "Trace execution"}.in_group("Debugging"), flags, 2}
+	};
+
+	auto out = render(other, cache);
+
+	ASSERT_NE(cache.key, key);
+	ASSERT_NE(out, "stale\n");
+}
+
+TEST(HelpCache, KeyedByChoiceFlags) {
+	uint64_t language;
+
+	auto english = conflict::parser{
+		conflict::choice{{'l', "language", "Language"}, conflict::choice_mode::replace, language,
+			conflict::flag{{"english"}, 1},
+			conflict::flag{{"polish"}, 2}
+		}
+	};
+
+	auto german = conflict::parser{
+		conflict::choice{{'l', "language", "Language"}, conflict::choice_mode::replace, language,
+			conflict::flag{{"english"}, 1},
+			conflict::flag{{"german"}, 2}
+		}
+	};
+
+	conflict::help_cache cache;
+
+	render(english, cache);
+	auto key = cache.key;
+
+	ASSERT_EQ(render(german, cache), render(german));
+	ASSERT_NE(cache.key, key);
+}
+
+TEST(HelpCache, Persisted) {
+	auto dir = std::filesystem::temp_directory_path() / "conflict-help-cache-test";
+	std::filesystem::remove_all(dir);
+	setenv("XDG_CACHE_HOME", dir.c_str(), 1);
+
+	auto expected = render(parser);
+
+	conflict::help_cache first{"conflict-test", "1.0"};
+	render(parser, first);
+
+	auto files = std::distance(std::filesystem::directory_iterator{dir / "conflict-test"},
+		std::filesystem::directory_iterator{});
+	ASSERT_EQ(files, 1);
+
+	// A later run reads the output back instead of rendering it.
+	for (auto &entry : std::filesystem::directory_iterator{dir / "conflict-test"})
+		std::ofstream{entry.path()} << "persisted\n";
+
+	conflict::help_cache second{"conflict-test", "1.0"};
+	ASSERT_EQ(render(parser, second), "persisted\n");
+
+	// A different version misses the persisted output.
+	conflict::help_cache third{"conflict-test", "2.0"};
+	ASSERT_EQ(render(parser, third), expected);
+
+	std::filesystem::remove_all(dir);
+	unsetenv("XDG_CACHE_HOME");
+}
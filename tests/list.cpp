@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+
+#include <conflict/list.hpp>
+#include <conflict/parser.hpp>
+
+namespace {
+
+std::vector<int> levels;
+std::vector<double> ratios;
+
+const auto parser = conflict::parser{
+	conflict::list_option{{'l', "level", "Levels"}, "n", levels},
+	conflict::list_option{{'r', "ratio", "Ratios"}, "x", ratios}
+};
+
+} // namespace anonymous
+
+TEST(List, Multiple) {
+	parser.apply_defaults();
+	auto st = parser.parse({"-l", "1", "--level=-2", "-l3", "--ratio", "0.5"});
+
+	ASSERT_TRUE(st);
+	ASSERT_EQ(st.err, conflict::error::ok);
+	ASSERT_EQ(levels.size(), 3);
+	ASSERT_EQ(levels[0], 1);
+	ASSERT_EQ(levels[1], -2);
+	ASSERT_EQ(levels[2], 3);
+	ASSERT_EQ(ratios.size(), 1);
+	ASSERT_EQ(ratios[0], 0.5);
+}
+
+TEST(List, Invalid) {
+	parser.apply_defaults();
+	auto st = parser.parse({"-l", "1x"});
+
+	ASSERT_FALSE(st);
+	ASSERT_EQ(st.err, conflict::error::invalid_argument);
+	ASSERT_EQ(st.what1, "1x");
+	ASSERT_EQ(st.what2, "level");
+}
+
+TEST(List, Missing) {
+	parser.apply_defaults();
+	auto st = parser.parse({"--level"});
+
+	ASSERT_FALSE(st);
+	ASSERT_EQ(st.err, conflict::error::missing_argument);
+	ASSERT_EQ(st.what1, "--level");
+}
+
+TEST(List, Fixed) {
+	conflict::fixed_vector<int, 2> values;
+
+	const auto fixed_parser = conflict::parser{
+		conflict::list_option{{'n', "number", "Numbers"}, "n", values}
+	};
+
+	auto st = fixed_parser.parse({"-n", "1", "-n2"});
+
+	ASSERT_TRUE(st);
+	ASSERT_EQ(st.err, conflict::error::ok);
+	ASSERT_EQ(values.size(), 2);
+	ASSERT_EQ(values[0], 1);
+	ASSERT_EQ(values[1], 2);
+
+	st = fixed_parser.parse({"-n", "3"});
+
+	ASSERT_FALSE(st);
+	ASSERT_EQ(st.err, conflict::error::too_many_values);
+	ASSERT_EQ(st.what1, "3");
+	ASSERT_EQ(st.what2, "number");
+
+	fixed_parser.apply_defaults();
+	ASSERT_TRUE(values.empty());
+
+	st = fixed_parser.parse({"-n", "3"});
+
+	ASSERT_TRUE(st);
+	ASSERT_EQ(values.size(), 1);
+	ASSERT_EQ(values[0], 3);
+}
@@ -30,3 +30,32 @@ TEST(Option, Invalid) {
 	ASSERT_EQ(st.err, conflict::error::invalid_option);
 	ASSERT_EQ(st.what1, "-1");
 }
+
+TEST(Option, UnexpectedValue) {
+	uint64_t flags = 0;
+
+	const auto parser = conflict::parser{
+		conflict::option{{'1', "opt1", "Option 1"}, flags, 1}
+	};
+
+	auto st = parser.parse({"--opt1=foo"});
+
+	ASSERT_FALSE(st);
+	ASSERT_EQ(st.err, conflict::error::invalid_argument);
+	ASSERT_EQ(st.what1, "foo");
+	ASSERT_EQ(st.what2, "opt1");
+}
+
+TEST(Option, LongPrefixIsNotMatch) {
+	uint64_t flags = 0;
+
+	const auto parser = conflict::parser{
+		conflict::option{{'1', "opt1", "Option 1"}, flags, 1}
+	};
+
+	auto st = parser.parse({"--opt1x"});
+
+	ASSERT_FALSE(st);
+	ASSERT_EQ(st.err, conflict::error::invalid_option);
+	ASSERT_EQ(st.what1, "--opt1x");
+}
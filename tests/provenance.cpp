@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+
+#include <conflict/choice.hpp>
+#include <conflict/option.hpp>
+#include <conflict/parser.hpp>
+#include <conflict/provenance.hpp>
+
+namespace {
+
+uint64_t flags;
+conflict::provenance flags_origin;
+uint64_t features;
+conflict::provenance features_origin;
+uint64_t language;
+conflict::provenance language_origin;
+
+const auto parser = conflict::parser{
+	conflict::option{{'a', "alpha", "Alpha"}, flags, 1, false, &flags_origin},
+	conflict::option{{'b', "bravo", "Bravo"}, flags, 2, conflict::option::is_default, &flags_origin},
+	conflict::option{{'c', "charlie", "Charlie"}, flags, 4},
+	conflict::choice{{'f', "features", "Features"}, conflict::choice_mode::combine, features, features_origin,
+		conflict::flag{{"all"}, 1 | 2 | 4, conflict::flag::is_default},
+		conflict::flag{{"feat1"}, 1},
+		conflict::flag{{"feat2"}, 2},
+		conflict::flag{{"feat3"}, 4},
+		conflict::flag{{"exp1"}, 8}
+	},
+	conflict::choice{{'l', "language", "Language"}, conflict::choice_mode::replace, language, language_origin,
+		conflict::flag{{"english"}, 1, conflict::flag::is_default},
+		conflict::flag{{"polish"}, 2}
+	}
+};
+
+} // namespace anonymous
+
+TEST(Provenance, Defaults) {
+	parser.apply_defaults();
+
+	ASSERT_EQ(flags_origin.of(1), conflict::source::none);
+	ASSERT_EQ(flags_origin.of(2), conflict::source::defaults);
+	ASSERT_EQ(features_origin.mask(conflict::source::defaults), 1 | 2 | 4);
+	ASSERT_EQ(features_origin.of(8), conflict::source::none);
+	ASSERT_EQ(language_origin.of(1), conflict::source::defaults);
+}
+
+TEST(Provenance, Sources) {
+	parser.apply_defaults();
+
+	auto st = parser.parse({"-f", "-feat2,exp1", "-l", "polish"}, nullptr, conflict::source::env);
+	ASSERT_TRUE(st);
+
+	st = parser.parse({"-ac", "-f", "feat2"});
+	ASSERT_TRUE(st);
+
+	ASSERT_EQ(flags, 1 | 2 | 4);
+	ASSERT_EQ(flags_origin.of(1), conflict::source::argv);
+	ASSERT_EQ(flags_origin.of(2), conflict::source::defaults);
+	// Not tracked.
+	ASSERT_EQ(flags_origin.of(4), conflict::source::none);
+
+	ASSERT_EQ(features, 1 | 2 | 4 | 8);
+	ASSERT_EQ(features_origin.of(1), conflict::source::defaults);
+	ASSERT_EQ(features_origin.of(2), conflict::source::argv);
+	ASSERT_EQ(features_origin.of(4), conflict::source::defaults);
+	ASSERT_EQ(features_origin.of(8), conflict::source::env);
+
+	ASSERT_EQ(language, 2);
+	ASSERT_EQ(language_origin.of(2), conflict::source::env);
+	ASSERT_EQ(conflict::source_name(language_origin.of(2)), "env");
+}
+
+TEST(Provenance, Reset) {
+	auto st = parser.parse({"-a"});
+	ASSERT_TRUE(st);
+	ASSERT_EQ(flags_origin.of(1), conflict::source::argv);
+
+	parser.apply_defaults();
+	ASSERT_EQ(flags_origin.of(1), conflict::source::none);
+}
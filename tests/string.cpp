@@ -101,3 +101,35 @@ TEST(String, MultiplMissing) {
 	ASSERT_EQ(st.err, conflict::error::missing_argument);
 	ASSERT_EQ(st.what1, "--opt2");
 }
+
+namespace {
+
+conflict::fixed_vector<std::string_view, 2> fixed_args;
+
+const auto fixed_parser = conflict::parser{
+	conflict::strings_option{{'I', "include", "Include"}, "dir", fixed_args}
+};
+
+} // namespace anonymous
+
+TEST(String, FixedMultiple) {
+	fixed_parser.apply_defaults();
+	auto st = fixed_parser.parse({"-I", "foo", "--include=bar"});
+
+	ASSERT_TRUE(st);
+	ASSERT_EQ(st.err, conflict::error::ok);
+	ASSERT_EQ(fixed_args.size(), 2);
+	ASSERT_EQ(fixed_args[0], "foo");
+	ASSERT_EQ(fixed_args[1], "bar");
+}
+
+TEST(String, FixedTooMany) {
+	fixed_parser.apply_defaults();
+	auto st = fixed_parser.parse({"-I", "foo", "-Ibar", "-I", "baz"});
+
+	ASSERT_FALSE(st);
+	ASSERT_EQ(st.err, conflict::error::too_many_values);
+	ASSERT_EQ(st.what1, "baz");
+	ASSERT_EQ(st.what2, "include");
+	ASSERT_EQ(fixed_args.size(), 2);
+}
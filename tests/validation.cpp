@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+
+#include <conflict/choice.hpp>
+#include <conflict/option.hpp>
+#include <conflict/string.hpp>
+#include <conflict/parser.hpp>
+
+namespace {
+
+uint64_t flags;
+uint64_t other_flags;
+uint64_t language;
+std::string_view output;
+
+constexpr auto parser = conflict::parser{
+	conflict::option{{'b', "bravo", "Option B"}, flags, 1},
+	conflict::option{{'a', "alpha", "Option A"}, flags, 2},
+	// The same bit may be reused for a different target.
+	conflict::option{{"charlie", "Option C"}, other_flags, 2},
+	conflict::string_option{{'o', "output", "Output"}, "file", output},
+	conflict::choice{{'l', "language", "Language"}, conflict::choice_mode::replace, language,
+		conflict::flag{{"english"}, 1, conflict::flag::is_default},
+		conflict::flag{{"polish"}, 2}
+	}
+};
+
+static_assert(parser.long_index.names[0] == "alpha");
+static_assert(parser.long_index.indices[0] == 1);
+static_assert(parser.long_index.names[4] == "output");
+
+} // namespace anonymous
+
+TEST(Validation, Constexpr) {
+	parser.apply_defaults();
+	auto st = parser.parse({"-a", "--charlie"});
+
+	ASSERT_TRUE(st);
+	ASSERT_EQ(st.err, conflict::error::ok);
+	ASSERT_EQ(flags, 2);
+	ASSERT_EQ(other_flags, 2);
+	ASSERT_EQ(language, 1);
+}
+
+TEST(ValidationDeathTest, DuplicateLong) {
+	ASSERT_DEATH((conflict::parser{
+		conflict::option{{'a', "opt", "Option A"}, flags, 1},
+		conflict::option{{'b', "opt", "Option B"}, flags, 2}
+	}), "duplicate long option name");
+}
+
+TEST(ValidationDeathTest, DuplicateShort) {
+	ASSERT_DEATH((conflict::parser{
+		conflict::option{{'a', "opt1", "Option 1"}, flags, 1},
+		conflict::string_option{{'a', "opt2", "Option 2"}, "file", output}
+	}), "duplicate short option name");
+}
+
+TEST(ValidationDeathTest, OverlappingBits) {
+	ASSERT_DEATH((conflict::parser{
+		conflict::option{{"opt1", "Option 1"}, flags, 1 | 2},
+		conflict::option{{"opt2", "Option 2"}, flags, 2}
+	}), "overlapping flag bits");
+}
+
+TEST(ValidationDeathTest, OverlappingChoiceBits) {
+	ASSERT_DEATH((conflict::parser{
+		conflict::option{{"opt", "Option"}, flags, 1},
+		conflict::choice{{"features"}, conflict::choice_mode::combine, flags,
+			conflict::flag{{"a"}, 1},
+			conflict::flag{{"b"}, 4}
+		}
+	}), "overlapping flag bits");
+}
+
+TEST(ValidationDeathTest, ReplaceDefaults) {
+	ASSERT_DEATH((conflict::choice{{"lang"}, conflict::choice_mode::replace, language,
+		conflict::flag{{"english"}, 1, conflict::flag::is_default},
+		conflict::flag{{"polish"}, 2, conflict::flag::is_default}
+	}), "multiple defaults");
+}
+
+TEST(ValidationDeathTest, DuplicateFlag) {
+	ASSERT_DEATH((conflict::choice{{"lang"}, conflict::choice_mode::combine, language,
+		conflict::flag{{"english"}, 1},
+		conflict::flag{{"english"}, 2}
+	}), "duplicate choice flag name");
+}
+
+TEST(ValidationDeathTest, SelfConstraint) {
+	auto p = conflict::parser{
+		conflict::option{{'a', "alpha"}, flags, 1},
+		conflict::option{{'b', "beta"}, flags, 2}
+	};
+
+	ASSERT_DEATH(p.constrain({conflict::required("alpha", "alpha")}), "option constrains itself");
+	ASSERT_DEATH(p.constrain({conflict::conflicts("beta", "beta")}), "option constrains itself");
+	ASSERT_DEATH(p.constrain({conflict::depends("alpha", "alpha")}), "option constrains itself");
+}
@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+
+#include <conflict/choice.hpp>
+#include <conflict/option.hpp>
+#include <conflict/string.hpp>
+#include <conflict/value.hpp>
+#include <conflict/list.hpp>
+#include <conflict/parser.hpp>
+
+namespace {
+
+struct duration {
+	uint64_t ms = 0;
+};
+
+enum class color {
+	none,
+	red,
+	green
+};
+
+} // namespace anonymous
+
+template <>
+struct conflict::value_parser<duration> {
+	static bool parse(std::string_view str, duration &value) {
+		uint64_t scale = 1;
+
+		if (str.size() > 2 && str.substr(str.size() - 2) == "ms") {
+			str.remove_suffix(2);
+		} else if (str.size() > 1 && str.back() == 's') {
+			str.remove_suffix(1);
+			scale = 1000;
+		} else {
+			return false;
+		}
+
+		if (!value_parser<uint64_t>::parse(str, value.ms))
+			return false;
+
+		value.ms *= scale;
+		return true;
+	}
+};
+
+template <>
+struct conflict::value_parser<color> {
+	static bool parse(std::string_view str, color &value) {
+		constexpr std::pair<std::string_view, color> table[] = {
+			{"red", color::red},
+			{"green", color::green}
+		};
+
+		for (auto [name, c] : table) {
+			if (str == name) {
+				value = c;
+				return true;
+			}
+		}
+
+		return false;
+	}
+};
+
+namespace {
+
+struct not_an_option {
+	conflict::option_info info;
+};
+
+static_assert(conflict::is_option_v<conflict::option>);
+static_assert(conflict::is_option_v<conflict::counter_option>);
+static_assert(conflict::is_option_v<conflict::string_option>);
+static_assert(conflict::is_option_v<conflict::strings_option<>>);
+static_assert(conflict::is_option_v<conflict::choice<2>>);
+static_assert(conflict::is_option_v<conflict::list_option<int>>);
+static_assert(conflict::is_option_v<conflict::value_option<duration>>);
+static_assert(!conflict::is_option_v<not_an_option>);
+static_assert(!conflict::is_option_v<int>);
+
+duration timeout;
+color colour;
+unsigned jobs;
+
+const auto parser = conflict::parser{
+	conflict::value_option{{'t', "timeout", "Timeout"}, "duration", timeout},
+	conflict::value_option{{'c', "color", "Color"}, "color", colour},
+	conflict::value_option{{'j', "jobs", "Jobs"}, "n", jobs}
+};
+
+} // namespace anonymous
+
+TEST(Value, Custom) {
+	parser.apply_defaults();
+	auto st = parser.parse({"-t", "2s", "--color=green", "-j8"});
+
+	ASSERT_TRUE(st);
+	ASSERT_EQ(st.err, conflict::error::ok);
+	ASSERT_EQ(timeout.ms, 2000);
+	ASSERT_EQ(colour, color::green);
+	ASSERT_EQ(jobs, 8);
+}
+
+TEST(Value, Defaults) {
+	parser.apply_defaults();
+	auto st = parser.parse({});
+
+	ASSERT_TRUE(st);
+	ASSERT_EQ(st.err, conflict::error::ok);
+	ASSERT_EQ(timeout.ms, 0);
+	ASSERT_EQ(colour, color::none);
+	ASSERT_EQ(jobs, 0);
+}
+
+TEST(Value, Invalid) {
+	parser.apply_defaults();
+	auto st = parser.parse({"--timeout", "15m"});
+
+	ASSERT_FALSE(st);
+	ASSERT_EQ(st.err, conflict::error::invalid_argument);
+	ASSERT_EQ(st.what1, "15m");
+	ASSERT_EQ(st.what2, "timeout");
+}
+
+TEST(Value, InvalidNumber) {
+	parser.apply_defaults();
+	auto st = parser.parse({"-j", "-1"});
+
+	ASSERT_FALSE(st);
+	ASSERT_EQ(st.err, conflict::error::invalid_argument);
+	ASSERT_EQ(st.what1, "-1");
+	ASSERT_EQ(st.what2, "jobs");
+}
+
+TEST(Value, InvalidKeepsTarget) {
+	parser.apply_defaults();
+	jobs = 5;
+	auto st = parser.parse({"--jobs=12abc"});
+
+	ASSERT_FALSE(st);
+	ASSERT_EQ(st.err, conflict::error::invalid_argument);
+	ASSERT_EQ(st.what1, "12abc");
+	ASSERT_EQ(jobs, 5);
+}